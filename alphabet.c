@@ -0,0 +1,200 @@
+/*
+     Implementation for module which maps the letters of a dictionary to
+        dense letter codes.
+*/
+#include "alphabet.h"
+#include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Exits as the words hold more letters than an alphabet can */
+static void tooManySymbols();
+/* Writes the lower case of the letter of length bytes at text to folded,
+    returning its length */
+static int foldSymbol(const char *text, int length, char *folded);
+
+/*******************************************************/
+/*
+    Fills the alphabet with every letter of the given words, numbering them
+    in ascending byte order. A single byte comes before every UTF-8
+    character it starts, so merging the single bytes into the sorted
+    characters of several bytes keeps that order.
+*/
+void buildAlphabet(struct alphabet *a, char **words, int wordCount) {
+    memset(a, 0, sizeof(struct alphabet));
+    bool seenByte[BYTE_VALUES] = {false};
+    /* distinct letters of several bytes, kept sorted */
+    char wide[MAX_SYMBOLS + 1][MAX_SYMBOL_BYTES + 1];
+    int wideCount = 0;
+
+    for (int i = 0; i < wordCount; i++) {
+        int length;
+        for (char *c = words[i]; *c; c += length) {
+            length = symbolLength(c);
+            if (length == 1) {
+                seenByte[(unsigned char) *c] = true;
+                continue;
+            }
+            char key[MAX_SYMBOL_BYTES + 1];
+            memcpy(key, c, length);
+            key[length] = '\0';
+            int low = 0;
+            int high = wideCount;
+            while (low < high) {
+                int mid = (low + high) / 2;
+                if (strcmp(wide[mid], key) < 0) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            if (low < wideCount && strcmp(wide[low], key) == 0) {
+                continue;
+            }
+            if (wideCount == MAX_SYMBOLS) {
+                tooManySymbols();
+            }
+            memmove(&wide[low + 1], &wide[low],
+                    sizeof(wide[0]) * (wideCount - low));
+            strcpy(wide[low], key);
+            wideCount++;
+        }
+    }
+
+    int count = 0;
+    int w = 0;
+    for (int b = 1; b <= BYTE_VALUES; b++) {
+        while (w < wideCount &&
+               (b == BYTE_VALUES || (unsigned char) wide[w][0] < b)) {
+            if (++count > MAX_SYMBOLS) {
+                tooManySymbols();
+            }
+            strcpy(a->symbols[count], wide[w++]);
+        }
+        if (b < BYTE_VALUES && seenByte[b]) {
+            if (++count > MAX_SYMBOLS) {
+                tooManySymbols();
+            }
+            a->symbols[count][0] = (char) b;
+            a->byteCodes[b] = count;
+        }
+    }
+    a->symbolCount = count;
+}
+
+/*
+    Exits as the words hold more letters than an alphabet can.
+*/
+static void tooManySymbols() {
+    fprintf(stderr, "Dictionary has more than %d distinct letters.\n",
+            MAX_SYMBOLS);
+    exit(EXIT_FAILURE);
+}
+
+/*
+    Returns the code of the letter of length bytes at text, by binary search
+    of the letters unless it is a single byte.
+*/
+int symbolCode(const struct alphabet *a, const char *text, int length) {
+    if (length == 1) {
+        return a->byteCodes[(unsigned char) *text];
+    }
+    char key[MAX_SYMBOL_BYTES + 1];
+    assert(length <= MAX_SYMBOL_BYTES);
+    memcpy(key, text, length);
+    key[length] = '\0';
+    int low = 1;
+    int high = a->symbolCount + 1;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (strcmp(a->symbols[mid], key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low <= a->symbolCount && strcmp(a->symbols[low], key) == 0 ?
+        low : NO_SYMBOL;
+}
+
+/*
+    Returns the code of the letter of length bytes at text once it is
+    folded to lower case.
+*/
+int foldedSymbolCode(const struct alphabet *a, const char *text, int length) {
+    char folded[MAX_SYMBOL_BYTES];
+    length = foldSymbol(text, length, folded);
+    return symbolCode(a, folded, length);
+}
+
+/*
+    Writes the lower case of the letter of length bytes at text to folded,
+    returning its length. Every capital folded is a two byte character whose
+    lower case is one too.
+*/
+static int foldSymbol(const char *text, int length, char *folded) {
+    memcpy(folded, text, length);
+    if (length == 1) {
+        if (*text >= 'A' && *text <= 'Z') {
+            *folded = *text - 'A' + 'a';
+        }
+        return length;
+    }
+    if (length != 2) {
+        return length;
+    }
+    int point = (((unsigned char) text[0] & 0x1F) << 6) |
+        ((unsigned char) text[1] & 0x3F);
+    int lower = point;
+    if ((point >= 0xC0 && point <= 0xDE && point != 0xD7) ||
+        (point >= 0x391 && point <= 0x3AB && point != 0x3A2) ||
+        (point >= 0x410 && point <= 0x42F)) {
+        /* Latin-1, Greek and Cyrillic capitals */
+        lower = point + 0x20;
+    } else if (point >= 0x400 && point <= 0x40F) {
+        lower = point + 0x50;
+    } else if (point == 0x178) {
+        lower = 0xFF;
+    } else if (((point >= 0x100 && point <= 0x137) ||
+                (point >= 0x14A && point <= 0x177)) && point != 0x130) {
+        /* Latin Extended-A pairs, capital first */
+        lower = point | 1;
+    } else if ((point >= 0x139 && point <= 0x148) ||
+               (point >= 0x179 && point <= 0x17E)) {
+        lower = point + (point & 1);
+    }
+    folded[0] = (char) (0xC0 | (lower >> 6));
+    folded[1] = (char) (0x80 | (lower & 0x3F));
+    return length;
+}
+
+/*
+    Writes the codes of the letters of text to codes, returning how many
+    there are, or -1 if a letter is not in the alphabet.
+*/
+int encodeSymbols(const struct alphabet *a, const char *text, char *codes) {
+    int count = 0;
+    int length;
+    for (const char *c = text; *c; c += length) {
+        length = symbolLength(c);
+        int code = symbolCode(a, c, length);
+        if (code == NO_SYMBOL) {
+            return -1;
+        }
+        codes[count++] = (char) code;
+    }
+    codes[count] = (char) NO_SYMBOL;
+    return count;
+}
+
+/*
+    Whether the letter with the given code is printed as a follow letter.
+*/
+bool isPrintedSymbol(const struct alphabet *a, int code) {
+    const char *text = a->symbols[code];
+    return text[1] ? true : isalpha((unsigned char) text[0]);
+}
+
+/*******************************************************/
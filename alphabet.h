@@ -0,0 +1,91 @@
+/*
+     Header for module which maps the letters of a dictionary to dense
+        letter codes 1 to symbolCount, so an index spells words in codes
+        that fit a single char whatever the letters are.
+
+     A letter is one UTF-8 character, such as an accented or non-Latin
+        letter, or a single byte where the text is not valid UTF-8. Codes
+        are given in the byte order of the letters, so words ordered by
+        their codes are in lexicographic order.
+*/
+#include <stdbool.h>
+
+#ifndef ALPHABET_DEF
+#define ALPHABET_DEF
+
+/* Most letters an alphabet holds, code 0 ending a string of codes */
+#define MAX_SYMBOLS 255
+/* Most bytes of one UTF-8 letter */
+#define MAX_SYMBOL_BYTES 4
+/* Number of distinct byte values */
+#define BYTE_VALUES 256
+/* Code of a letter outside the alphabet */
+#define NO_SYMBOL 0
+
+/* Letters of an alphabet and their codes. It holds no pointers, so it is
+    stored in index files as it is. */
+struct alphabet {
+    int symbolCount;
+    /* Code of each single byte letter, NO_SYMBOL for none. */
+    unsigned char byteCodes[BYTE_VALUES];
+    /* Text of the letter of each code, in ascending byte order from code 1.
+    */
+    char symbols[MAX_SYMBOLS + 1][MAX_SYMBOL_BYTES + 1];
+};
+
+/*
+    Returns the number of bytes of the letter text starts with: the length
+    of a complete UTF-8 character, or 1 for any other byte.
+*/
+static inline int symbolLength(const char *text) {
+    unsigned char lead = (unsigned char) text[0];
+    int length = lead < 0xC2 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 :
+                 lead < 0xF5 ? 4 : 1;
+    for (int i = 1; i < length; i++) {
+        if (((unsigned char) text[i] & 0xC0) != 0x80) {
+            return 1;
+        }
+    }
+    return length;
+}
+
+/*
+    Fills the alphabet with every letter of the given words. Exits if there
+    are more than MAX_SYMBOLS.
+*/
+void buildAlphabet(struct alphabet *a, char **words, int wordCount);
+
+/*
+    Returns the code of the letter of length bytes at text, NO_SYMBOL if it
+    is not in the alphabet.
+*/
+int symbolCode(const struct alphabet *a, const char *text, int length);
+
+/*
+    Returns the code of the letter of length bytes at text once it is
+    folded to lower case, as board letters are. Letters A to Z, and the
+    capitals of Latin-1, Latin Extended-A, Greek and Cyrillic are folded.
+*/
+int foldedSymbolCode(const struct alphabet *a, const char *text, int length);
+
+/*
+    Writes the codes of the letters of text to codes, which has room for one
+    per byte of text and a terminating NO_SYMBOL, and returns how many
+    there are, or -1 if a letter is not in the alphabet.
+*/
+int encodeSymbols(const struct alphabet *a, const char *text, char *codes);
+
+/*
+    Returns the text of the letter with the given code.
+*/
+static inline const char *symbolText(const struct alphabet *a, int code) {
+    return a->symbols[code];
+}
+
+/*
+    Whether the letter with the given code is printed as a follow letter: a
+    single byte letter a to z or A to Z, or any UTF-8 character.
+*/
+bool isPrintedSymbol(const struct alphabet *a, int code);
+
+#endif
@@ -0,0 +1,225 @@
+/*
+	Solves a batch of boards against one dictionary index shared by a pool
+	of worker threads, printing each board's solution in input order.
+
+	Usage: batchSolve part threads (dictionaryFile | -i indexFile) [boardList]
+
+	part is A, B or D. Each line of boardList (standard input if not given)
+	names a board file, followed for part B by its partial string file.
+	Each board's path and solution reach standard output in one write.
+	Per board solve and queue wait times are reported on standard error.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include "problem.h"
+#include "indexFile.h"
+#include "threadPool.h"
+#include "outputBuffer.h"
+
+#define MIN_ARGS 4
+#define USEC_PER_SEC 1e6
+/* Boards read, solved and printed at a time, bounding memory on streams */
+#define BATCH_CHUNK 4096
+#define MAX_LINE 4096
+
+struct boardJob {
+	char *boardPath;
+	char *partialPath;
+	struct problem *problem;
+	struct solution *solution;
+	/* Seconds from the chunk being queued to the job starting, and solving */
+	double waitTime;
+	double solveTime;
+	int worker;
+};
+
+struct batch {
+	char part;
+	struct solverContext **contexts;
+	struct boardJob *jobs;
+	double queuedAt;
+};
+
+/* Returns a monotonic time in seconds */
+static double now();
+/* Reads, then solves, one board on a worker thread */
+static void solveJob(void *arg, int taskIndex, int worker);
+
+int main(int argc, char **argv){
+	if(argc < MIN_ARGS || !strchr("ABD", argv[1][0])){
+		fprintf(stderr, "Usage: %s part threads (dictionaryFile | -i indexFile)"
+			" [boardList]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	struct batch b;
+	b.part = argv[1][0];
+	int threads = atoi(argv[2]);
+	if(threads < 1){
+		threads = 1;
+	}
+
+	/* One read-only index for all workers */
+	int arg = 3;
+	struct prefixTree *index;
+	struct problem *dictionary = NULL;
+	if(strcmp(argv[arg], "-i") == 0 && arg + 1 < argc){
+		index = mapIndexFile(argv[arg + 1]);
+		if(!index){
+			return EXIT_FAILURE;
+		}
+		arg += 2;
+	} else {
+		FILE *dictFile = fopen(argv[arg], "r");
+		if(!dictFile){
+			perror("Encountered error opening dictionary file");
+			return EXIT_FAILURE;
+		}
+		dictionary = readDictionary(dictFile);
+		fclose(dictFile);
+		if(b.part == 'D'){
+			/* part D can never find a word repeating a letter */
+			dropRepeatedLetterWords(dictionary);
+		}
+		index = buildDictionaryIndex(dictionary);
+		arg++;
+	}
+	FILE *list = stdin;
+	if(arg < argc && !(list = fopen(argv[arg], "r"))){
+		perror("Encountered error opening board list");
+		return EXIT_FAILURE;
+	}
+
+	b.contexts = (struct solverContext **) 
+		malloc(sizeof(struct solverContext *) * threads);
+	b.jobs = (struct boardJob *) malloc(sizeof(struct boardJob) * BATCH_CHUNK);
+	if(!b.contexts || !b.jobs){
+		perror("Encountered error allocating batch");
+		return EXIT_FAILURE;
+	}
+	for(int i = 0; i < threads; i++){
+		b.contexts[i] = newSolverContextFromIndex(index);
+	}
+
+	struct outputBuffer *output = newOutputBuffer();
+	double start = now();
+	double totalSolve = 0, totalWait = 0, maxSolve = 0, maxWait = 0;
+	int boardCount = 0;
+	char line[MAX_LINE];
+	bool more = true;
+	while(more){
+		/* Queue a chunk of boards */
+		int jobCount = 0;
+		while(jobCount < BATCH_CHUNK && 
+			  (more = fgets(line, MAX_LINE, list) != NULL)){
+			char *boardPath = strtok(line, " \t\r\n");
+			if(!boardPath){
+				continue;
+			}
+			char *partialPath = strtok(NULL, " \t\r\n");
+			struct boardJob *job = &b.jobs[jobCount++];
+			job->boardPath = strdup(boardPath);
+			job->partialPath = partialPath ? strdup(partialPath) : NULL;
+		}
+		b.queuedAt = now();
+		runTasks(jobCount, threads, solveJob, &b);
+
+		/* Report in input order */
+		for(int i = 0; i < jobCount; i++){
+			struct boardJob *job = &b.jobs[i];
+			appendOutput(output, job->boardPath, strlen(job->boardPath));
+			appendOutputChar(output, '\n');
+			appendSolution(output, job->problem, job->solution);
+			writeOutput(output, STDOUT_FILENO);
+			fprintf(stderr, "%s\tsolve %.0f us\twait %.0f us\tworker %d\n", 
+				job->boardPath, job->solveTime * USEC_PER_SEC, 
+				job->waitTime * USEC_PER_SEC, job->worker);
+			totalSolve += job->solveTime;
+			totalWait += job->waitTime;
+			if(job->solveTime > maxSolve){
+				maxSolve = job->solveTime;
+			}
+			if(job->waitTime > maxWait){
+				maxWait = job->waitTime;
+			}
+			freeSolution(job->solution, job->problem);
+			freeProblem(job->problem);
+			free(job->boardPath);
+			free(job->partialPath);
+		}
+		boardCount += jobCount;
+	}
+	double elapsed = now() - start;
+
+	if(boardCount > 0){
+		fprintf(stderr, "%d boards on %d threads in %.3f s (%.1f boards/s)\n"
+			"solve mean %.0f us max %.0f us, wait mean %.0f us max %.0f us\n",
+			boardCount, threads, elapsed, boardCount / elapsed, 
+			totalSolve / boardCount * USEC_PER_SEC, maxSolve * USEC_PER_SEC,
+			totalWait / boardCount * USEC_PER_SEC, maxWait * USEC_PER_SEC);
+	}
+
+	for(int i = 0; i < threads; i++){
+		freeSolverContext(b.contexts[i]);
+	}
+	free(b.contexts);
+	free(b.jobs);
+	freeOutputBuffer(output);
+	freeTree(index);
+	if(dictionary){
+		freeProblem(dictionary);
+	}
+	if(list != stdin){
+		fclose(list);
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+	Returns a monotonic time in seconds.
+*/
+static double now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+	Reads, then solves, one board on a worker thread with its own context.
+*/
+static void solveJob(void *arg, int taskIndex, int worker){
+	struct batch *b = (struct batch *) arg;
+	struct boardJob *job = &b->jobs[taskIndex];
+	double started = now();
+	job->waitTime = started - b->queuedAt;
+	job->worker = worker;
+
+	FILE *boardFile = fopen(job->boardPath, "r");
+	if(!boardFile){
+		perror(job->boardPath);
+		exit(EXIT_FAILURE);
+	}
+	if(b->part == 'B'){
+		FILE *partialFile = job->partialPath ? 
+			fopen(job->partialPath, "r") : NULL;
+		if(!partialFile){
+			fprintf(stderr, "%s: part B needs a partial string file\n", 
+				job->boardPath);
+			exit(EXIT_FAILURE);
+		}
+		job->problem = readProblemB(NULL, boardFile, partialFile);
+		fclose(partialFile);
+		job->solution = solveBoardB(b->contexts[worker], job->problem);
+	} else if(b->part == 'D'){
+		job->problem = readProblemD(NULL, boardFile);
+		job->solution = solveBoardD(b->contexts[worker], job->problem);
+	} else {
+		job->problem = readProblemA(NULL, boardFile);
+		job->solution = solveBoardA(b->contexts[worker], job->problem);
+	}
+	fclose(boardFile);
+	job->solveTime = now() - started;
+}
@@ -0,0 +1,118 @@
+/*
+	Benchmarks the part A solver on random boards of one dimension.
+
+	Usage: benchBoards dictionaryFile dimension boardCount [seed]
+
+	Board letters are drawn with roughly English letter frequencies, and the
+	mean solve time is reported.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "problem.h"
+
+#define MIN_ARGS 4
+#define USEC_PER_SEC 1e6
+#define DEFAULT_SEED 1
+
+/* Board letters, each repeated by its rough frequency in English text */
+static char letters[] = "eeeeeeeeeeeettttttttttaaaaaaaaooooooooiiiiiii"
+	"nnnnnnnsssssssrrrrrrhhhhhhdddddlllllccccuuuummmwwffggyyppbbvkjxqz";
+
+/* Returns a monotonic time in seconds */
+static double now();
+/* Writes a random board of the given dimension to a new string */
+static char *randomBoard(int dimension);
+/* Solves the board text, adding the solve time to elapsed */
+static void solveBoardText(struct solverContext *ctx, char *boardText,
+	double *elapsed);
+
+int main(int argc, char **argv){
+	if(argc < MIN_ARGS){
+		fprintf(stderr, "Usage: %s dictionaryFile dimension boardCount [seed]"
+			"\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	int dimension = atoi(argv[2]);
+	int boardCount = atoi(argv[3]);
+	srand(argc > MIN_ARGS ? atoi(argv[MIN_ARGS]) : DEFAULT_SEED);
+	if(dimension < 1 || boardCount < 1){
+		fprintf(stderr, "dimension and boardCount must be positive\n");
+		return EXIT_FAILURE;
+	}
+
+	FILE *dictFile = fopen(argv[1], "r");
+	if(!dictFile){
+		perror("Encountered error opening dictionary file");
+		return EXIT_FAILURE;
+	}
+	struct problem *dictionary = readDictionary(dictFile);
+	fclose(dictFile);
+	struct solverContext *ctx = newSolverContext(dictionary);
+
+	double elapsed = 0;
+	for(int i = 0; i < boardCount; i++){
+		char *boardText = randomBoard(dimension);
+		solveBoardText(ctx, boardText, &elapsed);
+		free(boardText);
+	}
+
+	printf("%d %dx%d boards\nmean %.1f us\n", boardCount, dimension, 
+		dimension, elapsed / boardCount * USEC_PER_SEC);
+
+	freeSolverContext(ctx);
+	freeProblem(dictionary);
+	return EXIT_SUCCESS;
+}
+
+/*
+	Returns a monotonic time in seconds.
+*/
+static double now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+	Writes a random board of the given dimension in board file format, one
+	row per line with letters separated by spaces.
+*/
+static char *randomBoard(int dimension){
+	char *boardText = (char *) malloc(2 * dimension * dimension + 1);
+	if(!boardText){
+		perror("Encountered error allocating board");
+		exit(EXIT_FAILURE);
+	}
+	char *c = boardText;
+	for(int row = 0; row < dimension; row++){
+		for(int col = 0; col < dimension; col++){
+			*c++ = letters[rand() % (sizeof(letters) - 1)];
+			*c++ = col + 1 < dimension ? ' ' : '\n';
+		}
+	}
+	*c = '\0';
+	return boardText;
+}
+
+/*
+	Solves the board text, adding the solve time to elapsed.
+*/
+static void solveBoardText(struct solverContext *ctx, char *boardText,
+	double *elapsed){
+	FILE *boardFile = fmemopen(boardText, strlen(boardText), "r");
+	if(!boardFile){
+		perror("Encountered error opening board");
+		exit(EXIT_FAILURE);
+	}
+	struct problem *p = readProblemA(NULL, boardFile);
+	fclose(boardFile);
+
+	double started = now();
+	struct solution *s = solveBoardA(ctx, p);
+	*elapsed += now() - started;
+
+	freeSolution(s, p);
+	freeProblem(p);
+}
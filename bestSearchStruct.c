@@ -0,0 +1,11 @@
+/*
+    Implementation for data structure used in looking for the best 
+        scoring word of a board.
+*/
+/* Search for the best scoring word of a board. */
+struct bestSearch {
+    struct scoreBounds *bounds;
+    const struct scoreTable *table;
+    int best;
+    int bestWord;
+};
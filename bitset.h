@@ -0,0 +1,32 @@
+/*    
+     Header for small fixed size bitsets stored as arrays of 64-bit words.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef BITSET_DEF
+#define BITSET_DEF
+
+#define BITS_PER_WORD 64
+
+/* Number of words needed to hold the given number of bits */
+static inline int bitsetWords(int bits) {
+    return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+}
+
+static inline void setBit(uint64_t *set, int i) {
+    set[i / BITS_PER_WORD] |= (uint64_t) 1 << (i % BITS_PER_WORD);
+}
+
+static inline bool testBit(uint64_t *set, int i) {
+    return (set[i / BITS_PER_WORD] >> (i % BITS_PER_WORD)) & 1;
+}
+
+/* Clears the lowest set bit of a non-zero word and returns its index */
+static inline int takeLowestBit(uint64_t *word) {
+    int i = __builtin_ctzll(*word);
+    *word &= *word - 1;
+    return i;
+}
+
+#endif
@@ -0,0 +1,21 @@
+/*
+    Implementation for data structure used in filtering dictionary words 
+        by the letters of a board before an index is built for it.
+*/
+/* Letters a to z, those a board prefilter knows */
+#define BOARD_LETTERS 26
+
+/* Letters of one board that dictionary words are checked against before 
+    they go into an index built for that board alone. */
+struct boardLetters {
+    /* Cells holding each letter. */
+    int counts[BOARD_LETTERS];
+    /* Bit b of adjacent[a] is set when a cell of letter a neighbours a cell
+        of letter b. */
+    uint32_t adjacent[BOARD_LETTERS];
+    /* Whether a word may use a letter more often than the board holds it,
+        as part B may by reusing cells. */
+    bool reuse;
+    /* Whether a board piece is outside a to z, so words are not filtered. */
+    bool unfiltered;
+};
@@ -0,0 +1,45 @@
+/*
+	Builds a dictionary index file once, so solvers can map it with 
+	mapIndexFile at start up instead of reading and indexing the dictionary.
+
+	Usage: buildIndex dictionaryFile indexFile [trie|dawg]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "problem.h"
+#include "indexFile.h"
+
+#define MIN_ARGS 3
+#define INDEX_TYPE_ARG 3
+
+int main(int argc, char **argv){
+	if(argc < MIN_ARGS){
+		fprintf(stderr, "Usage: %s dictionaryFile indexFile [trie|dawg]\n", 
+			argv[0]);
+		return EXIT_FAILURE;
+	}
+	FILE *dictFile = fopen(argv[1], "r");
+	if(!dictFile){
+		perror("Encountered error opening dictionary file");
+		return EXIT_FAILURE;
+	}
+	struct problem *p = readDictionary(dictFile);
+	fclose(dictFile);
+	if(argc > INDEX_TYPE_ARG && strcmp(argv[INDEX_TYPE_ARG], "dawg") == 0){
+		setIndexType(p, INDEX_DAWG);
+	}
+
+	struct prefixTree *t = buildDictionaryIndex(p);
+	FILE *indexFile = fopen(argv[2], "wb");
+	if(!indexFile){
+		perror("Encountered error opening index file");
+		return EXIT_FAILURE;
+	}
+	writeIndexFile(t, indexFile);
+	fclose(indexFile);
+
+	freeTree(t);
+	freeProblem(p);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,462 @@
+/*    
+     Implementation for module which builds a directed acyclic word graph 
+        (DAWG) over the dictionary.
+
+     Words are added in sorted order. Once a word is added, the states only 
+        used by the previous word can no longer change, so each of them is 
+        either replaced by an equivalent state from the register or added to
+        it (Daciuk et al. incremental construction). The final states are
+        then laid out into a prefix tree node pool, each state's outgoing 
+        edges becoming one run of sibling nodes shared by all its parents.
+*/
+#include "dawg.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DOUBLE 2
+/* Number of states and edges to allocate space for initially */
+#define INITIALSTATEALLOCATION 64
+#define INITIALEDGEALLOCATION 2
+/* Register size, kept a power of two and at most half full */
+#define INITIALREGISTERSIZE 1024
+#define NO_STATE (-1)
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+/* A state of the automaton while it is being built */
+struct dawgState {
+    bool final;
+    int edgeCount;
+    int edgeAllocated;
+    /* Letters of outgoing edges, in ascending order, and their targets */
+    char *letters;
+    int *targets;
+    /* Number of words accepted from this state, -1 if not counted yet */
+    int words;
+    /* Pool index of the first edge once laid out, NO_NODE if not yet */
+    int block;
+};
+
+/* A word to add and the letter codes it is spelled in */
+struct dawgWord {
+    char *codes;
+    char *word;
+};
+
+struct dawgBuilder {
+    struct dawgState *states;
+    int stateCount;
+    int stateAllocated;
+    /* Hash set of registered state indexes, NO_STATE for empty slots */
+    int *reg;
+    int regSize;
+    int regCount;
+};
+
+static int newState(struct dawgBuilder *b);
+static void addEdge(struct dawgBuilder *b, int from, char c, int to);
+static uint32_t hashState(struct dawgState *s);
+static bool sameState(struct dawgState *s1, struct dawgState *s2);
+static int registerState(struct dawgBuilder *b, int state);
+static void minimise(struct dawgBuilder *b, int *path, int from, int to);
+static int countWords(struct dawgBuilder *b, int state, int *edges);
+static void layoutState(struct dawgBuilder *b, struct prefixTree *t, int state);
+static int compareWords(const void *w1, const void *w2);
+static int sharedPrefix(char *word1, char *word2, int len);
+static struct prefixTree *buildDawg(struct dawgWord *sorted, int wordCount, 
+                                    const struct alphabet *a);
+
+/*******************************************************/
+/*
+    Builds the DAWG of all distinct words given, spelled in the codes of the
+    given alphabet, which holds every letter of the words.
+*/
+struct prefixTree *newDawg(char **words, int wordCount, 
+                           const struct alphabet *a) {
+    size_t textSize = 0;
+    for (int i = 0; i < wordCount; i++) {
+        textSize += strlen(words[i]) + 1;
+    }
+    struct dawgWord *sorted = (struct dawgWord *) 
+        malloc(sizeof(struct dawgWord) * (wordCount + 1));
+    char *text = (char *) malloc(textSize + 1);
+    assert(sorted && text);
+    char *next = text;
+    for (int i = 0; i < wordCount; i++) {
+        int length = encodeSymbols(a, words[i], next);
+        assert(length >= 0);
+        sorted[i].codes = next;
+        sorted[i].word = words[i];
+        next += length + 1;
+    }
+    struct prefixTree *t = buildDawg(sorted, wordCount, a);
+    free(sorted);
+    free(text);
+    return t;
+}
+
+/*
+    Builds the DAWG of the given words, sorting them by their codes and 
+    dropping duplicates first.
+*/
+static struct prefixTree *buildDawg(struct dawgWord *sorted, int wordCount, 
+                                    const struct alphabet *a) {
+    struct dawgBuilder b;
+    int i;
+
+    qsort(sorted, wordCount, sizeof(struct dawgWord), compareWords);
+    int unique = 0;
+    int maxLen = 0;
+    for (i = 0; i < wordCount; i++) {
+        if (unique == 0 || 
+            strcmp(sorted[unique - 1].codes, sorted[i].codes) != 0) {
+            sorted[unique++] = sorted[i];
+            int len = strlen(sorted[i].codes);
+            if (len > maxLen) {
+                maxLen = len;
+            }
+        }
+    }
+
+    b.stateCount = 0;
+    b.stateAllocated = INITIALSTATEALLOCATION;
+    b.states = (struct dawgState *) malloc(sizeof(struct dawgState) * 
+                                           b.stateAllocated);
+    assert(b.states);
+    b.regSize = INITIALREGISTERSIZE;
+    b.regCount = 0;
+    b.reg = (int *) malloc(sizeof(int) * b.regSize);
+    assert(b.reg);
+    for (i = 0; i < b.regSize; i++) {
+        b.reg[i] = NO_STATE;
+    }
+
+    /* path[d] is the state reached by the first d letters of the last word */
+    int *path = (int *) malloc(sizeof(int) * (maxLen + 1));
+    assert(path);
+    path[0] = newState(&b);
+    char *prev = DEFAULT_STR;
+    int prevLen = 0;
+
+    for (i = 0; i < unique; i++) {
+        char *word = sorted[i].codes;
+        int len = strlen(word);
+        int common = 0;
+        while (common < len && common < prevLen && 
+               word[common] == prev[common]) {
+            common++;
+        }
+        /* the previous word's states past the common prefix are finished */
+        minimise(&b, path, prevLen, common);
+        for (int d = common; d < len; d++) {
+            path[d + 1] = newState(&b);
+            addEdge(&b, path[d], word[d], path[d + 1]);
+        }
+        b.states[path[len]].final = true;
+        prev = word;
+        prevLen = len;
+    }
+    minimise(&b, path, prevLen, 0);
+
+    /* Lay out reachable states into a node pool, node 0 standing for root */
+    int edges = 0;
+    countWords(&b, path[0], &edges);
+    struct prefixTree *t = (struct prefixTree *) 
+        malloc(sizeof(struct prefixTree));
+    assert(t);
+    t->nodeAllocated = edges + 1;
+    t->nodes = (struct trieNode *) malloc(sizeof(struct trieNode) * 
+                                          t->nodeAllocated);
+    assert(t->nodes);
+    t->nodeCount = 1;
+    struct trieNode *root = &t->nodes[ROOT_NODE];
+    root->letter = NULL_CHAR;
+    root->isEnd = b.states[path[0]].final;
+    root->numChild = b.states[path[0]].edgeCount;
+    root->wordId = NO_WORD;
+    root->wordsBefore = 0;
+    root->nextSibling = NO_NODE;
+    layoutState(&b, t, path[0]);
+    root->firstChild = b.states[path[0]].block;
+    assert(t->nodeCount == t->nodeAllocated);
+    t->wordPool = NULL;
+    t->wordOffsets = NULL;
+    t->alphabet = *a;
+    t->mapping = NULL;
+    t->mappingSize = 0;
+    char **words = (char **) malloc(sizeof(char *) * (unique + 1));
+    assert(words);
+    for (i = 0; i < unique; i++) {
+        words[i] = sorted[i].word;
+    }
+    setWordPool(t, words, unique);
+
+    for (i = 0; i < b.stateCount; i++) {
+        free(b.states[i].letters);
+        free(b.states[i].targets);
+    }
+    free(b.states);
+    free(b.reg);
+    free(path);
+    free(words);
+    return t;
+}
+
+/*
+    Builds the DAWG of the reversed prefixes of the index's words, in the 
+    index's letter codes, which its word pool is spelled in as well. The 
+    words are in the order of their codes, so a prefix is new exactly when 
+    it is longer than the prefix its word shares with the word before.
+*/
+struct prefixTree *newReversePrefixDawg(struct prefixTree *t) {
+    /* Spell the words in codes, each no longer than its text */
+    char **codes = (char **) malloc(sizeof(char *) * (t->wordCount + 1));
+    char *codeText = (char *) malloc(t->wordOffsets[t->wordCount] + 1);
+    assert(codes && codeText);
+    char *next = codeText;
+    for (int w = 0; w < t->wordCount; w++) {
+        codes[w] = next;
+        int length = encodeSymbols(&t->alphabet, getWord(t, w), next);
+        assert(length >= 0);
+        next += length + 1;
+    }
+
+    int prefixCount = 0;
+    long textSize = 0;
+    for (int w = 0; w < t->wordCount; w++) {
+        int len = strlen(codes[w]);
+        int common = w > 0 ? sharedPrefix(codes[w - 1], codes[w], len) : 0;
+        prefixCount += len - common;
+        textSize += (long) (len - common) * (len + common + 3) / 2;
+    }
+
+    struct dawgWord *prefixes = (struct dawgWord *) 
+        malloc(sizeof(struct dawgWord) * (prefixCount + 1));
+    char *text = (char *) malloc(textSize + 1);
+    assert(prefixes && text);
+    next = text;
+    int count = 0;
+    for (int w = 0; w < t->wordCount; w++) {
+        char *word = codes[w];
+        int len = strlen(word);
+        int common = w > 0 ? sharedPrefix(codes[w - 1], word, len) : 0;
+        for (int k = common + 1; k <= len; k++) {
+            prefixes[count].codes = prefixes[count].word = next;
+            count++;
+            for (int i = k - 1; i >= 0; i--) {
+                *next++ = word[i];
+            }
+            *next++ = NULL_CHAR;
+        }
+    }
+    assert(count == prefixCount && next - text <= textSize);
+
+    struct prefixTree *reverse = buildDawg(prefixes, prefixCount, 
+                                           &t->alphabet);
+    /* its pool is spelled in codes, one per letter of the longest word */
+    reverse->maxWordLength = t->maxWordLength;
+    free(prefixes);
+    free(text);
+    free(codes);
+    free(codeText);
+    return reverse;
+}
+
+/*
+    Returns the length of the prefix two words share, at most len.
+*/
+static int sharedPrefix(char *word1, char *word2, int len) {
+    int common = 0;
+    while (common < len && word1[common] && word1[common] == word2[common]) {
+        common++;
+    }
+    return common;
+}
+
+/*
+    Appends a new state with no edges and returns its index.
+*/
+static int newState(struct dawgBuilder *b) {
+    if (b->stateCount >= b->stateAllocated) {
+        b->states = (struct dawgState *) realloc(b->states, 
+            sizeof(struct dawgState) * b->stateAllocated * DOUBLE);
+        assert(b->states);
+        b->stateAllocated *= DOUBLE;
+    }
+    struct dawgState *s = &b->states[b->stateCount];
+    s->final = false;
+    s->edgeCount = 0;
+    s->edgeAllocated = 0;
+    s->letters = NULL;
+    s->targets = NULL;
+    s->words = -1;
+    s->block = NO_NODE;
+    return b->stateCount++;
+}
+
+/*
+    Adds an edge after all existing edges of a state, input being sorted 
+    keeps them in ascending letter order.
+*/
+static void addEdge(struct dawgBuilder *b, int from, char c, int to) {
+    struct dawgState *s = &b->states[from];
+    if (s->edgeCount >= s->edgeAllocated) {
+        s->edgeAllocated = s->edgeAllocated ? s->edgeAllocated * DOUBLE : 
+                                              INITIALEDGEALLOCATION;
+        s->letters = (char *) realloc(s->letters, s->edgeAllocated);
+        s->targets = (int *) realloc(s->targets, 
+                                     sizeof(int) * s->edgeAllocated);
+        assert(s->letters && s->targets);
+    }
+    s->letters[s->edgeCount] = c;
+    s->targets[s->edgeCount] = to;
+    s->edgeCount++;
+}
+
+/*
+    Hashes the right language of a state, its targets being canonical.
+*/
+static uint32_t hashState(struct dawgState *s) {
+    uint32_t h = FNV_OFFSET ^ (s->final ? 1 : 0);
+    for (int i = 0; i < s->edgeCount; i++) {
+        h = (h ^ (unsigned char) s->letters[i]) * FNV_PRIME;
+        h = (h ^ (uint32_t) s->targets[i]) * FNV_PRIME;
+    }
+    return h;
+}
+
+/*
+    Checks whether two states accept the same suffixes.
+*/
+static bool sameState(struct dawgState *s1, struct dawgState *s2) {
+    if (s1->final != s2->final || s1->edgeCount != s2->edgeCount) {
+        return false;
+    }
+    return s1->edgeCount == 0 || 
+        (memcmp(s1->letters, s2->letters, s1->edgeCount) == 0 &&
+         memcmp(s1->targets, s2->targets, sizeof(int) * s1->edgeCount) == 0);
+}
+
+/*
+    Returns the registered state equivalent to given state, registering the
+    state itself if there is none.
+*/
+static int registerState(struct dawgBuilder *b, int state) {
+    if ((b->regCount + 1) * DOUBLE > b->regSize) {
+        /* grow and rehash */
+        int oldSize = b->regSize;
+        int *old = b->reg;
+        b->regSize *= DOUBLE;
+        b->reg = (int *) malloc(sizeof(int) * b->regSize);
+        assert(b->reg);
+        for (int i = 0; i < b->regSize; i++) {
+            b->reg[i] = NO_STATE;
+        }
+        for (int i = 0; i < oldSize; i++) {
+            if (old[i] != NO_STATE) {
+                uint32_t j = hashState(&b->states[old[i]]) & (b->regSize - 1);
+                while (b->reg[j] != NO_STATE) {
+                    j = (j + 1) & (b->regSize - 1);
+                }
+                b->reg[j] = old[i];
+            }
+        }
+        free(old);
+    }
+
+    struct dawgState *s = &b->states[state];
+    uint32_t i = hashState(s) & (b->regSize - 1);
+    while (b->reg[i] != NO_STATE) {
+        if (sameState(&b->states[b->reg[i]], s)) {
+            return b->reg[i];
+        }
+        i = (i + 1) & (b->regSize - 1);
+    }
+    b->reg[i] = state;
+    b->regCount++;
+    return state;
+}
+
+/*
+    Replaces or registers the states path[to + 1..from], deepest first, 
+    each being the last child of the state before it.
+*/
+static void minimise(struct dawgBuilder *b, int *path, int from, int to) {
+    for (int d = from; d > to; d--) {
+        int canonical = registerState(b, path[d]);
+        if (canonical != path[d]) {
+            struct dawgState *parent = &b->states[path[d - 1]];
+            parent->targets[parent->edgeCount - 1] = canonical;
+            struct dawgState *dup = &b->states[path[d]];
+            free(dup->letters);
+            free(dup->targets);
+            dup->letters = NULL;
+            dup->targets = NULL;
+            dup->edgeCount = 0;
+        }
+    }
+}
+
+/*
+    Counts words accepted from each reachable state, adding the number of 
+    edges of every state reached for the first time to edges.
+*/
+static int countWords(struct dawgBuilder *b, int state, int *edges) {
+    struct dawgState *s = &b->states[state];
+    if (s->words >= 0) {
+        return s->words;
+    }
+    int words = s->final ? 1 : 0;
+    for (int i = 0; i < s->edgeCount; i++) {
+        words += countWords(b, s->targets[i], edges);
+    }
+    /* states array is not resized here so s is still valid */
+    s->words = words;
+    *edges += s->edgeCount;
+    return words;
+}
+
+/*
+    Lays out the edges of a state as a run of sibling nodes, then its 
+    targets, unless it was laid out through another parent already.
+*/
+static void layoutState(struct dawgBuilder *b, struct prefixTree *t, 
+                        int state) {
+    struct dawgState *s = &b->states[state];
+    if (s->block != NO_NODE || s->edgeCount == 0) {
+        return;
+    }
+    int block = s->block = t->nodeCount;
+    t->nodeCount += s->edgeCount;
+    int before = 0;
+    for (int i = 0; i < s->edgeCount; i++) {
+        struct dawgState *target = &b->states[s->targets[i]];
+        struct trieNode *n = &t->nodes[block + i];
+        n->letter = s->letters[i];
+        n->isEnd = target->final;
+        n->numChild = target->edgeCount;
+        n->wordId = NO_WORD;
+        n->wordsBefore = before;
+        n->nextSibling = i + 1 < s->edgeCount ? block + i + 1 : NO_NODE;
+        before += target->words;
+    }
+    for (int i = 0; i < s->edgeCount; i++) {
+        layoutState(b, t, s->targets[i]);
+        t->nodes[block + i].firstChild = b->states[s->targets[i]].block;
+    }
+}
+
+/*
+    Orders words by their codes, the same way prefix tree children are 
+    ordered.
+*/
+static int compareWords(const void *w1, const void *w2) {
+    return strcmp(((struct dawgWord *) w1)->codes, 
+                  ((struct dawgWord *) w2)->codes);
+}
+
+/*******************************************************/
@@ -0,0 +1,26 @@
+/*    
+     Header for module which builds a directed acyclic word graph (DAWG), 
+        the minimal acyclic automaton of the dictionary. Equal suffixes 
+        share nodes, but the result uses the same node layout as the prefix
+        tree so every solver can walk either one.
+*/
+#include "prefixTree.h"
+
+/*
+    Builds the DAWG of all distinct words given, spelled in the codes of the
+    given alphabet. Words are numbered in the order of their codes, exactly
+    like a prefix tree of the same words, and the result is freed with 
+    freeTree.
+*/
+struct prefixTree *newDawg(char **words, int wordCount, 
+                           const struct alphabet *a);
+
+/*
+    Builds the DAWG of every prefix of the words of the given index, each 
+    spelled backwards. A string is spelled from its root exactly when it is
+    some word's substring read backwards, and ends at an end of word node 
+    when read forwards it is a prefix of a word, so a search can grow word 
+    prefixes backwards from their last letter. Its word pool holds the 
+    reversed prefixes in letter codes.
+*/
+struct prefixTree *newReversePrefixDawg(struct prefixTree *t);
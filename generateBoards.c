@@ -0,0 +1,338 @@
+/*
+	Searches for high scoring part A boards by local search from a random
+	roll of Boggle dice.
+
+	Usage: generateBoards (classic|letters) dimension steps
+		(dictionaryFile | -i indexFile) [seed] [temperature]
+
+	Each step rerolls the die of one random cell. Once the paths of the
+	starting board are counted, a step only walks the paths through the
+	changed cell, in one pass taking out the old letter's paths and adding
+	the new one's, so a word's score counts while some path spells it. With
+	no temperature, or 0, a step is kept only if the score does not drop
+	(hill climbing). Otherwise a drop of d is kept with probability
+	exp(-d / T), as T cools linearly from temperature to 0 (simulated
+	annealing).
+
+	The best board reaches standard output in board file format. Its score,
+	checked by a full solve, and the evaluations per second of the single
+	search thread are reported on standard error.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include "problem.h"
+#include "prefixTree.h"
+#include "indexFile.h"
+#include "dawg.h"
+#include "scoring.h"
+
+#define MIN_ARGS 5
+#define DEFAULT_SEED 1
+#define DIE_FACES 6
+/* Tries at rolling a die to a letter other than its current one */
+#define REROLL_TRIES 8
+
+/* Dice of the 4x4 game */
+static const char *smallDice[] = {
+	"aaeegn", "abbjoo", "achops", "affkps", "aoottw", "cimotu", "deilrx",
+	"delrvy", "distty", "eeghnw", "eeinsu", "ehrtvw", "eiosst", "elrtty",
+	"himnqu", "hlnnrz"
+};
+/* Dice of the 5x5 game, reused in turn for other sizes */
+static const char *bigDice[] = {
+	"aaafrs", "aaeeee", "aafirs", "adennn", "aeeeem", "aeegmu", "aegmnn",
+	"afirsy", "bjkqxz", "ccenst", "ceiilt", "ceilpt", "ceipst", "ddhnot",
+	"dhhlor", "dhlnor", "dhlnor", "eiiitt", "emottt", "ensssu", "fiprsy",
+	"gorrvw", "iprrry", "nootuw", "ooottu"
+};
+
+/* Word path counts of the current board and the score they add up to */
+struct boardCounts {
+	const struct scoreTable *table;
+	/* Paths spelling each word */
+	int *pathCounts;
+	/* Score change of the paths walked so far */
+	long delta;
+	/* Words of the paths walked in this step, to take a rejected step back,
+		-1 - wordNumber for a path taken out */
+	int *journal;
+	int journalCount;
+	int journalAllocated;
+};
+
+/* Returns a monotonic time in seconds */
+static double now();
+/* Returns a random number in [0, 1) */
+static double randomUnit();
+/* Shuffles the dice onto the cells and rolls each */
+static void rollBoard(const char **dice, int cells, char *letters);
+/* Consumers counting a path of a word added or taken out */
+static bool addPath(void *arg, int wordNumber, const char *word,
+	const int *path, int pathLength);
+static bool removePath(void *arg, int wordNumber, const char *word,
+	const int *path, int pathLength);
+/* Adds step to the path count of a word, scoring it as it appears or goes */
+static void countPath(struct boardCounts *counts, int wordNumber, 
+	const char *word, int length, int step);
+/* Writes the board in board file format */
+static void printBoard(FILE *f, char *letters, int dimension);
+
+int main(int argc, char **argv){
+	if(argc < MIN_ARGS || (strcmp(argv[1], "classic") != 0 &&
+						   strcmp(argv[1], "letters") != 0)){
+		fprintf(stderr, "Usage: %s (classic|letters) dimension steps "
+			"(dictionaryFile | -i indexFile) [seed] [temperature]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	struct scoreTable table;
+	if(strcmp(argv[1], "classic") == 0){
+		classicScoreTable(&table);
+	} else {
+		letterSumScoreTable(&table);
+	}
+	int dimension = atoi(argv[2]);
+	long steps = atol(argv[3]);
+	if(dimension < 1 || steps < 0){
+		fprintf(stderr, "dimension must be positive and steps not negative\n");
+		return EXIT_FAILURE;
+	}
+
+	int arg = 4;
+	struct prefixTree *index;
+	struct problem *dictionary = NULL;
+	if(strcmp(argv[arg], "-i") == 0 && arg + 1 < argc){
+		index = mapIndexFile(argv[arg + 1]);
+		if(!index){
+			return EXIT_FAILURE;
+		}
+		arg += 2;
+	} else {
+		FILE *dictFile = fopen(argv[arg], "r");
+		if(!dictFile){
+			perror("Encountered error opening dictionary file");
+			return EXIT_FAILURE;
+		}
+		dictionary = readDictionary(dictFile);
+		fclose(dictFile);
+		index = buildDictionaryIndex(dictionary);
+		arg++;
+	}
+	srand(arg < argc ? atoi(argv[arg]) : DEFAULT_SEED);
+	double temperature = arg + 1 < argc ? atof(argv[arg + 1]) : 0;
+
+	struct solverContext *ctx = newSolverContextFromIndex(index);
+	struct prefixTree *reversePrefixes = newReversePrefixDawg(index);
+
+	/* Roll the starting board and read it like a board file */
+	int cells = dimension * dimension;
+	const char **dice = (const char **) malloc(sizeof(char *) * cells);
+	char *letters = (char *) malloc(cells);
+	char *best = (char *) malloc(cells);
+	if(!dice || !letters || !best){
+		perror("Encountered error allocating board");
+		return EXIT_FAILURE;
+	}
+	rollBoard(dice, cells, letters);
+	char *boardText = NULL;
+	size_t boardSize = 0;
+	FILE *boardFile = open_memstream(&boardText, &boardSize);
+	if(!boardFile){
+		perror("Encountered error writing board");
+		return EXIT_FAILURE;
+	}
+	printBoard(boardFile, letters, dimension);
+	fclose(boardFile);
+	boardFile = fmemopen(boardText, boardSize, "r");
+	if(!boardFile){
+		perror("Encountered error reading board");
+		return EXIT_FAILURE;
+	}
+	struct problem *p = readProblemA(NULL, boardFile);
+	fclose(boardFile);
+	free(boardText);
+
+	struct boardCounts counts = {&table, NULL, 0, NULL, 0, 0};
+	counts.pathCounts = (int *) calloc(index->wordCount, sizeof(int));
+	counts.journalAllocated = cells;
+	counts.journal = (int *) malloc(sizeof(int) * counts.journalAllocated);
+	if(!counts.pathCounts || !counts.journal){
+		perror("Encountered error allocating path counts");
+		return EXIT_FAILURE;
+	}
+
+	double start = now();
+	walkPathsA(ctx, p, addPath, &counts);
+	long score = counts.delta;
+	long bestScore = score;
+	memcpy(best, letters, cells);
+	long accepted = 0;
+
+	for(long i = 0; i < steps; i++){
+		int cell = rand() % cells;
+		char old = letters[cell];
+		char letter = old;
+		for(int try = 0; try < REROLL_TRIES && letter == old; try++){
+			letter = dice[cell][rand() % DIE_FACES];
+		}
+		if(letter == old){
+			continue;
+		}
+
+		counts.delta = 0;
+		counts.journalCount = 0;
+		walkLetterChangeA(ctx, p, reversePrefixes, cell, letter, removePath, addPath, 
+			&counts);
+
+		double cooled = temperature * (1 - (double) i / steps);
+		if(counts.delta >= 0 ||
+		   (cooled > 0 && randomUnit() < exp(counts.delta / cooled))){
+			score += counts.delta;
+			letters[cell] = letter;
+			setBoardLetter(p, cell, letter);
+			accepted++;
+			if(score > bestScore){
+				bestScore = score;
+				memcpy(best, letters, cells);
+			}
+		} else {
+			for(int j = 0; j < counts.journalCount; j++){
+				int w = counts.journal[j];
+				if(w < 0){
+					counts.pathCounts[-1 - w]++;
+				} else {
+					counts.pathCounts[w]--;
+				}
+			}
+		}
+	}
+	double elapsed = now() - start;
+
+	/* Check the best board with a full solve */
+	for(int i = 0; i < cells; i++){
+		setBoardLetter(p, i, best[i]);
+	}
+	struct boardScore *checked = scoreBoardA(ctx, p, &table, 0);
+	printBoard(stdout, best, dimension);
+	fprintf(stderr, "best score %ld (%d words), solved score %ld\n"
+		"%ld steps, %ld kept in %.3f s, %.0f evaluations/s on one core\n",
+		bestScore, checked->wordCount, checked->total, steps, accepted,
+		elapsed, steps / elapsed);
+
+	freeBoardScore(checked);
+	free(counts.pathCounts);
+	free(counts.journal);
+	free(dice);
+	free(letters);
+	free(best);
+	freeProblem(p);
+	freeTree(reversePrefixes);
+	freeSolverContext(ctx);
+	freeTree(index);
+	if(dictionary){
+		freeProblem(dictionary);
+	}
+	return EXIT_SUCCESS;
+}
+
+/*
+	Returns a monotonic time in seconds.
+*/
+static double now(){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+	Returns a random number in [0, 1).
+*/
+static double randomUnit(){
+	return rand() / ((double) RAND_MAX + 1);
+}
+
+/*
+	Shuffles the dice of the game of the board's size onto the cells and
+	rolls each, recording which die each cell holds.
+*/
+static void rollBoard(const char **dice, int cells, char *letters){
+	const char **set = bigDice;
+	int setSize = sizeof(bigDice) / sizeof(char *);
+	if(cells == sizeof(smallDice) / sizeof(char *)){
+		set = smallDice;
+		setSize = cells;
+	}
+	for(int i = 0; i < cells; i++){
+		dice[i] = set[i % setSize];
+	}
+	for(int i = cells - 1; i > 0; i--){
+		int j = rand() % (i + 1);
+		const char *die = dice[i];
+		dice[i] = dice[j];
+		dice[j] = die;
+	}
+	for(int i = 0; i < cells; i++){
+		letters[i] = dice[i][rand() % DIE_FACES];
+	}
+}
+
+/*
+	Counts a path of a word on the new board.
+*/
+static bool addPath(void *arg, int wordNumber, const char *word,
+	const int *path, int pathLength){
+	countPath((struct boardCounts *) arg, wordNumber, word, pathLength, 1);
+	return true;
+}
+
+/*
+	Takes out a path of a word on the old board.
+*/
+static bool removePath(void *arg, int wordNumber, const char *word,
+	const int *path, int pathLength){
+	countPath((struct boardCounts *) arg, wordNumber, word, pathLength, -1);
+	return true;
+}
+
+/*
+	Adds step to the path count of a word and journals it. A word starts or
+	stops scoring when its first path is added or its last taken out.
+*/
+static void countPath(struct boardCounts *counts, int wordNumber, 
+	const char *word, int length, int step){
+	int *count = &counts->pathCounts[wordNumber];
+	if(step > 0 && *count == 0){
+		counts->delta += scoreWord(counts->table, word, length);
+	} else if(step < 0 && *count == 1){
+		counts->delta -= scoreWord(counts->table, word, length);
+	}
+	*count += step;
+
+	if(counts->journalCount >= counts->journalAllocated){
+		counts->journalAllocated *= 2;
+		counts->journal = (int *) realloc(counts->journal,
+			sizeof(int) * counts->journalAllocated);
+		if(!counts->journal){
+			perror("Encountered error allocating journal");
+			exit(EXIT_FAILURE);
+		}
+	}
+	counts->journal[counts->journalCount++] = 
+		step > 0 ? wordNumber : -1 - wordNumber;
+}
+
+/*
+	Writes the board in board file format, one row per line with letters
+	separated by spaces.
+*/
+static void printBoard(FILE *f, char *letters, int dimension){
+	for(int row = 0; row < dimension; row++){
+		for(int col = 0; col < dimension; col++){
+			fprintf(f, "%c%c", letters[row * dimension + col],
+				col + 1 < dimension ? ' ' : '\n');
+		}
+	}
+}
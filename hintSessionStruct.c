@@ -0,0 +1,33 @@
+/*
+    Implementation for data structure used in keeping a part B hint session,
+        the state of the search for one partial string typed a letter at a 
+        time, so each keystroke only extends or drops one level of it.
+*/
+struct hintSession {
+    /* Context searched, whose board scratch the session keeps using. */
+    struct solverContext *ctx;
+    /* Problem holding the board, and the partial string typed first. */
+    struct problem *problem;
+
+    /* Letter codes of the partial string typed so far, length letters. */
+    char *prefix;
+    int length;
+    /* Levels allocated for the arrays below, one per prefix length. */
+    int levelAllocated;
+    /* Index node spelling the first i letters, NULL when no word starts 
+        with them. */
+    struct trieNode **nodes;
+    /* Board bitset, boardWords words per level, of the cells where paths 
+        spelling the first i letters end. Cells may repeat along a path in 
+        part B, so these cells are all a path's future depends on. */
+    uint64_t *frontier;
+    /* Whether the follow letters of level i are worked out yet, and which 
+        letters they are, MAX_CHAR flags per level. */
+    bool *followKnown;
+    bool *followFound;
+
+    /* Board bitsets, boardWords words per letter, searched when working 
+        out whether a word can be completed. */
+    uint64_t *scratch;
+    int scratchDepth;
+};
@@ -0,0 +1,416 @@
+/*    
+     Implementation for module which saves a built dictionary index to a 
+        file and maps it back read-only.
+*/
+#include "indexFile.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define INDEX_MAGIC "BOGGLEIX"
+#define INDEX_MAGIC_SIZE 8
+#define INDEX_VERSION 4
+/* Every section starts on a multiple of this */
+#define SECTION_ALIGN 8
+
+/* Layout of the start of an index file, followed by the alphabet, the node
+    pool, the word offsets and the word pool at the given file offsets. */
+struct indexFileHeader {
+    char magic[INDEX_MAGIC_SIZE];
+    uint32_t version;
+    /* Size of a node, so files from a different layout are rejected */
+    uint32_t nodeSize;
+    int32_t nodeCount;
+    int32_t wordCount;
+    int32_t maxWordLength;
+    uint64_t alphabetOffset;
+    uint64_t nodesOffset;
+    uint64_t offsetsOffset;
+    uint64_t poolOffset;
+    uint64_t poolSize;
+    uint64_t fileSize;
+};
+
+/* Progress of a node through the check of the node pool */
+#define NODE_UNSEEN 0
+#define NODE_OPEN 1
+#define NODE_DONE 2
+
+/* Rounds offset up to the next section boundary */
+static uint64_t alignSection(uint64_t offset);
+/* Writes size bytes then pads up to the next section boundary */
+static void writeSection(FILE *f, void *data, uint64_t size);
+/* Whether count items of size bytes at offset lie inside the file */
+static bool sectionInFile(uint64_t offset, uint64_t count, uint64_t size, 
+                          uint64_t fileSize);
+/* Whether every section the header gives lies inside the mapped file */
+static bool sectionsInFile(struct indexFileHeader *h, char *base);
+/* Whether the alphabet's symbol count, byte codes and symbols are in range */
+static bool alphabetValid(const struct alphabet *a);
+/* Whether every node's links, letter and word numbers are in range */
+static bool nodesValid(struct indexFileHeader *h, struct trieNode *nodes, 
+                       const struct alphabet *a);
+/* Counts the words below the nodes in a walk from the root */
+static bool countDepthFirst(struct indexFileHeader *h, struct trieNode *nodes,
+                            int *words, int *height);
+/* Counts the words below a node from those below its children */
+static bool countBelow(struct indexFileHeader *h, struct trieNode *nodes, 
+                       int i, int *words, int *height);
+/* Whether the node is in range and its child run holds consecutive 
+    siblings in ascending letter order */
+static bool nodeValid(struct indexFileHeader *h, struct trieNode *nodes, 
+                      int i, const struct alphabet *a);
+/* Unmaps a file which is not a usable index, returning NULL */
+static struct prefixTree *rejectIndexFile(void *mapping, size_t size, 
+                                          char *indexPath, char *reason);
+
+/*******************************************************/
+/*
+    Writes the index to the given file.
+*/
+void writeIndexFile(struct prefixTree *t, FILE *indexFile) {
+    struct indexFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, INDEX_MAGIC, INDEX_MAGIC_SIZE);
+    h.version = INDEX_VERSION;
+    h.nodeSize = sizeof(struct trieNode);
+    h.nodeCount = t->nodeCount;
+    h.wordCount = t->wordCount;
+    h.maxWordLength = t->maxWordLength;
+    h.poolSize = t->wordOffsets[t->wordCount];
+
+    h.alphabetOffset = alignSection(sizeof(h));
+    h.nodesOffset = alignSection(h.alphabetOffset + sizeof(struct alphabet));
+    h.offsetsOffset = alignSection(h.nodesOffset + 
+                                   sizeof(struct trieNode) * h.nodeCount);
+    h.poolOffset = alignSection(h.offsetsOffset + 
+                                sizeof(int) * (h.wordCount + 1));
+    h.fileSize = alignSection(h.poolOffset + h.poolSize);
+
+    writeSection(indexFile, &h, sizeof(h));
+    writeSection(indexFile, &t->alphabet, sizeof(struct alphabet));
+    writeSection(indexFile, t->nodes, sizeof(struct trieNode) * h.nodeCount);
+    writeSection(indexFile, t->wordOffsets, sizeof(int) * (h.wordCount + 1));
+    writeSection(indexFile, t->wordPool, h.poolSize);
+    if (fflush(indexFile) != 0) {
+        perror("Encountered error writing index file");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+    Maps the index file at the given path read-only, returning NULL if it is
+    not a usable index. The node pool and alphabet are checked once here, so
+    searches can follow the index's links without checking them again.
+*/
+struct prefixTree *mapIndexFile(char *indexPath) {
+    int fd = open(indexPath, O_RDONLY);
+    if (fd == -1) {
+        perror("Encountered error opening index file");
+        exit(EXIT_FAILURE);
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror("Encountered error reading index file");
+        exit(EXIT_FAILURE);
+    }
+    if ((size_t) st.st_size < sizeof(struct indexFileHeader)) {
+        close(fd);
+        fprintf(stderr, "%s is not an index file.\n", indexPath);
+        return NULL;
+    }
+    void *mapping = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        perror("Encountered error mapping index file");
+        exit(EXIT_FAILURE);
+    }
+    /* the mapping stays valid once the descriptor is closed */
+    close(fd);
+
+    struct indexFileHeader *h = (struct indexFileHeader *) mapping;
+    if (memcmp(h->magic, INDEX_MAGIC, INDEX_MAGIC_SIZE) != 0 || 
+        h->version != INDEX_VERSION || 
+        h->nodeSize != sizeof(struct trieNode) || 
+        h->fileSize != (uint64_t) st.st_size) {
+        return rejectIndexFile(mapping, st.st_size, indexPath, 
+                               "not an index file for this build");
+    }
+    if (!sectionsInFile(h, (char *) mapping) || 
+        !alphabetValid((struct alphabet *) 
+                       ((char *) mapping + h->alphabetOffset)) || 
+        !nodesValid(h, (struct trieNode *) ((char *) mapping + 
+                                            h->nodesOffset), 
+                    (struct alphabet *) 
+                    ((char *) mapping + h->alphabetOffset))) {
+        return rejectIndexFile(mapping, st.st_size, indexPath, 
+                               "a damaged index file");
+    }
+
+    struct prefixTree *t = (struct prefixTree *) 
+        malloc(sizeof(struct prefixTree));
+    assert(t);
+    char *base = (char *) mapping;
+    t->nodes = (struct trieNode *) (base + h->nodesOffset);
+    t->nodeCount = t->nodeAllocated = h->nodeCount;
+    t->wordOffsets = (int *) (base + h->offsetsOffset);
+    t->wordPool = base + h->poolOffset;
+    t->wordCount = h->wordCount;
+    t->maxWordLength = h->maxWordLength;
+    memcpy(&t->alphabet, base + h->alphabetOffset, sizeof(struct alphabet));
+    t->mapping = mapping;
+    t->mappingSize = st.st_size;
+    return t;
+}
+
+/*
+    Whether count items of size bytes at offset lie inside a file of 
+    fileSize bytes, checked without overflow whatever the header holds.
+*/
+static bool sectionInFile(uint64_t offset, uint64_t count, uint64_t size, 
+                          uint64_t fileSize) {
+    return offset % SECTION_ALIGN == 0 && offset <= fileSize && 
+        count <= (fileSize - offset) / size;
+}
+
+/*
+    Whether every section the header of the mapped file gives lies inside 
+    it: the alphabet, the node pool, the word offsets and the word pool, 
+    with every word offset inside the word pool. The header's fileSize is 
+    already known to be the size of the file. The pool's words are not read
+    here, so its pages are only loaded as words are used. Its last byte 
+    ending a word is enough to keep every word read inside the pool.
+*/
+static bool sectionsInFile(struct indexFileHeader *h, char *base) {
+    if (h->nodeCount < 1 || h->wordCount < 0 || h->maxWordLength < 0 || 
+        !sectionInFile(h->alphabetOffset, 1, sizeof(struct alphabet), 
+                       h->fileSize) || 
+        !sectionInFile(h->nodesOffset, h->nodeCount, 
+                       sizeof(struct trieNode), h->fileSize) || 
+        !sectionInFile(h->offsetsOffset, (uint64_t) h->wordCount + 1, 
+                       sizeof(int), h->fileSize) || 
+        !sectionInFile(h->poolOffset, h->poolSize, 1, h->fileSize)) {
+        return false;
+    }
+    /* words start in order inside the pool, each ending before the next */
+    int *wordOffsets = (int *) (base + h->offsetsOffset);
+    char *wordPool = base + h->poolOffset;
+    if (wordOffsets[0] != 0 || 
+        (uint64_t) wordOffsets[h->wordCount] != h->poolSize || 
+        (h->poolSize > 0 && wordPool[h->poolSize - 1] != NULL_CHAR)) {
+        return false;
+    }
+    for (int i = 0; i < h->wordCount; i++) {
+        if (wordOffsets[i + 1] <= wordOffsets[i] || 
+            (uint64_t) wordOffsets[i + 1] > h->poolSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+    Whether the alphabet has at most MAX_SYMBOLS symbols, every byte code is
+    one of them and every symbol's text ends inside its slot.
+*/
+static bool alphabetValid(const struct alphabet *a) {
+    if (a->symbolCount < 0 || a->symbolCount > MAX_SYMBOLS) {
+        return false;
+    }
+    for (int b = 0; b < BYTE_VALUES; b++) {
+        if (a->byteCodes[b] > a->symbolCount) {
+            return false;
+        }
+    }
+    for (int i = 0; i <= MAX_SYMBOLS; i++) {
+        if (!memchr(a->symbols[i], NULL_CHAR, MAX_SYMBOL_BYTES + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+    Whether every node of the pool is in range: its letter a symbol of the 
+    alphabet, its children a run of consecutive siblings inside the pool in
+    ascending letter order, with no path leading back to a node on it. The 
+    words below each node are counted, so every word number is checked to 
+    be the count of the words before it, inside the word pool, and the 
+    longest path to be the longest word. A prefix tree lays every child run
+    out after its parent, so it is counted in one sweep back through the 
+    pool; a DAWG shares runs laid out earlier, so it is walked instead.
+*/
+static bool nodesValid(struct indexFileHeader *h, struct trieNode *nodes, 
+                       const struct alphabet *a) {
+    int count = h->nodeCount;
+    bool forward = true;
+    for (int i = 0; i < count; i++) {
+        if (!nodeValid(h, nodes, i, a)) {
+            return false;
+        }
+        if (nodes[i].numChild > 0 && nodes[i].firstChild <= i) {
+            forward = false;
+        }
+    }
+    if (nodes[ROOT_NODE].nextSibling != NO_NODE || 
+        nodes[ROOT_NODE].wordsBefore != 0) {
+        return false;
+    }
+
+    int *words = (int *) malloc(sizeof(int) * count);
+    int *height = (int *) malloc(sizeof(int) * count);
+    assert(words && height);
+    bool valid = true;
+    if (forward) {
+        /* no path leads back when every run comes after its parent */
+        for (int i = count - 1; i >= 0 && valid; i--) {
+            valid = countBelow(h, nodes, i, words, height);
+        }
+    } else {
+        valid = countDepthFirst(h, nodes, words, height);
+    }
+    valid = valid && words[ROOT_NODE] == h->wordCount && 
+        height[ROOT_NODE] == h->maxWordLength;
+    free(words);
+    free(height);
+    return valid;
+}
+
+/*
+    Counts the words below the nodes reached from the root depth-first, 
+    each once all its children are, failing on a path leading back to a 
+    node on it. The walk keeps its own stack, as a damaged pool may be 
+    deeper than the program's stack.
+*/
+static bool countDepthFirst(struct indexFileHeader *h, struct trieNode *nodes,
+                            int *words, int *height) {
+    int count = h->nodeCount;
+    char *state = (char *) calloc(count, sizeof(char));
+    int *stack = (int *) malloc(sizeof(int) * count);
+    int *next = (int *) malloc(sizeof(int) * count);
+    assert(state && stack && next);
+    bool valid = true;
+    state[ROOT_NODE] = NODE_OPEN;
+    stack[0] = ROOT_NODE;
+    next[0] = 0;
+    int depth = 1;
+    while (valid && depth > 0) {
+        int i = stack[depth - 1];
+        if (next[depth - 1] < nodes[i].numChild) {
+            int c = nodes[i].firstChild + next[depth - 1]++;
+            if (state[c] == NODE_OPEN) {
+                valid = false;
+            } else if (state[c] == NODE_UNSEEN) {
+                state[c] = NODE_OPEN;
+                stack[depth] = c;
+                next[depth++] = 0;
+            }
+        } else {
+            valid = countBelow(h, nodes, i, words, height);
+            state[i] = NODE_DONE;
+            depth--;
+        }
+    }
+    free(state);
+    free(stack);
+    free(next);
+    return valid;
+}
+
+/*
+    Counts the words below node i and the letters of its longest path down,
+    from those of its children, checking each child's word number is the 
+    count of the words below its earlier siblings.
+*/
+static bool countBelow(struct indexFileHeader *h, struct trieNode *nodes, 
+                       int i, int *words, int *height) {
+    struct trieNode *n = &nodes[i];
+    long long below = 0;
+    height[i] = 0;
+    for (int j = 0; j < n->numChild; j++) {
+        int c = n->firstChild + j;
+        if (nodes[c].wordsBefore != below) {
+            return false;
+        }
+        below += words[c];
+        if (height[c] + 1 > height[i]) {
+            height[i] = height[c] + 1;
+        }
+    }
+    below += n->isEnd ? 1 : 0;
+    words[i] = (int) below;
+    return below <= h->wordCount && height[i] <= h->maxWordLength;
+}
+
+/*
+    Whether node i has a letter of the alphabet, the root excepted, and a 
+    run of children inside the pool in ascending letter order linked as 
+    consecutive siblings, and a word number base inside the word pool.
+*/
+static bool nodeValid(struct indexFileHeader *h, struct trieNode *nodes, 
+                      int i, const struct alphabet *a) {
+    struct trieNode *n = &nodes[i];
+    int letter = (unsigned char) n->letter;
+    if ((i == ROOT_NODE ? letter != NULL_CHAR : 
+         letter < 1 || letter > a->symbolCount) || 
+        n->wordsBefore < 0 || n->wordsBefore > h->wordCount || 
+        n->numChild < 0 || n->numChild > a->symbolCount) {
+        return false;
+    }
+    if (n->numChild == 0) {
+        return n->firstChild == NO_NODE;
+    }
+    if (n->firstChild <= ROOT_NODE || 
+        n->firstChild > h->nodeCount - n->numChild) {
+        return false;
+    }
+    struct trieNode *run = &nodes[n->firstChild];
+    for (int j = 0; j < n->numChild; j++) {
+        int sibling = j + 1 < n->numChild ? n->firstChild + j + 1 : NO_NODE;
+        if (run[j].nextSibling != sibling || 
+            (j > 0 && (unsigned char) run[j].letter <= 
+                      (unsigned char) run[j - 1].letter)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+    Reports that the file at indexPath is the given reason, and unmaps it. 
+    Returns NULL for mapIndexFile to return.
+*/
+static struct prefixTree *rejectIndexFile(void *mapping, size_t size, 
+                                          char *indexPath, char *reason) {
+    fprintf(stderr, "%s is %s.\n", indexPath, reason);
+    munmap(mapping, size);
+    return NULL;
+}
+
+/*
+    Rounds offset up to the next section boundary.
+*/
+static uint64_t alignSection(uint64_t offset) {
+    return (offset + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+}
+
+/*
+    Writes size bytes then pads up to the next section boundary.
+*/
+static void writeSection(FILE *f, void *data, uint64_t size) {
+    char padding[SECTION_ALIGN] = {0};
+    if (fwrite(data, 1, size, f) != size || 
+        fwrite(padding, 1, alignSection(size) - size, f) != 
+            alignSection(size) - size) {
+        perror("Encountered error writing index file");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*******************************************************/
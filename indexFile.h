@@ -0,0 +1,24 @@
+/*    
+     Header for module which saves a built dictionary index (prefix tree or
+        DAWG with its word pool) to a file and maps it back read-only.
+        
+     The file only holds pool indexes and offsets, never pointers, so it can
+        be mapped at any address and its pages shared between processes.
+*/
+#include <stdio.h>
+#include "prefixTree.h"
+
+/*
+    Writes the index to the given file.
+*/
+void writeIndexFile(struct prefixTree *t, FILE *indexFile);
+
+/*
+    Maps the index file at the given path read-only. No words can be added to
+    the result, which is released with freeTree. Returns NULL, reporting 
+    why, if the file was written by another build or is damaged: a section 
+    or word offset outside the file, an alphabet or node out of range, a 
+    node pool looping back on itself, or word numbers or a longest word not
+    matching the word pool.
+*/
+struct prefixTree *mapIndexFile(char *indexPath);
@@ -0,0 +1,45 @@
+/*
+     Header for finding the board cells holding a letter as a bitset,
+        comparing 32 cells at once with AVX2 or 16 with SSE2 when the
+        compiler targets them, and one cell at a time otherwise.
+*/
+#include <stdint.h>
+#include "bitset.h"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#ifndef LETTERSCAN_DEF
+#define LETTERSCAN_DEF
+
+/* Sets the bit of each of the given cells of the board holding letter in
+    mask, which must start out clear. */
+static inline void scanLetterCells(const char *board, int cells, char letter,
+    uint64_t *mask) {
+    int i = 0;
+#if defined(__AVX2__)
+    __m256i wide = _mm256_set1_epi8(letter);
+    for (; i + 32 <= cells; i += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i *) (board + i));
+        uint32_t bits = (uint32_t)
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, wide));
+        mask[i / BITS_PER_WORD] |= (uint64_t) bits << (i % BITS_PER_WORD);
+    }
+#endif
+#if defined(__SSE2__)
+    __m128i narrow = _mm_set1_epi8(letter);
+    for (; i + 16 <= cells; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *) (board + i));
+        uint32_t bits = (uint32_t)
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, narrow));
+        mask[i / BITS_PER_WORD] |= (uint64_t) bits << (i % BITS_PER_WORD);
+    }
+#endif
+    for (; i < cells; i++) {
+        if (board[i] == letter) {
+            setBit(mask, i);
+        }
+    }
+}
+
+#endif
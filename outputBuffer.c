@@ -0,0 +1,74 @@
+/*    
+     Implementation for module which collects output text in one growable 
+        buffer and writes it out at once.
+*/
+#include "outputBuffer.h"
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DOUBLE 2
+/* Number of bytes to allocate space for initially */
+#define INITIALOUTPUTALLOCATION 4096
+
+/*******************************************************/
+/*
+    Creates an empty output buffer.
+*/
+struct outputBuffer *newOutputBuffer() {
+    struct outputBuffer *b = (struct outputBuffer *) 
+        malloc(sizeof(struct outputBuffer));
+    assert(b);
+    b->allocated = INITIALOUTPUTALLOCATION;
+    b->length = 0;
+    b->text = (char *) malloc(b->allocated);
+    assert(b->text);
+    return b;
+}
+
+/*
+    Appends length bytes of text to the buffer, growing it as needed.
+*/
+void appendOutput(struct outputBuffer *b, const char *text, size_t length) {
+    if (b->length + length > b->allocated) {
+        while (b->length + length > b->allocated) {
+            b->allocated *= DOUBLE;
+        }
+        b->text = (char *) realloc(b->text, b->allocated);
+        assert(b->text);
+    }
+    memcpy(b->text + b->length, text, length);
+    b->length += length;
+}
+
+/*
+    Writes all buffered text to the file descriptor and empties the buffer.
+*/
+void writeOutput(struct outputBuffer *b, int fd) {
+    size_t written = 0;
+    while (written < b->length) {
+        ssize_t n = write(fd, b->text + written, b->length - written);
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Encountered error writing output");
+            exit(EXIT_FAILURE);
+        }
+        written += n;
+    }
+    b->length = 0;
+}
+
+/* 
+    Frees the buffer.
+*/
+void freeOutputBuffer(struct outputBuffer *b) {
+    if (b) {
+        free(b->text);
+        free(b);
+    }
+}
@@ -0,0 +1,49 @@
+/*    
+     Header for module which collects output text in one growable buffer, 
+        so a whole board's results reach the output in a single write.
+*/
+#include <stddef.h>
+
+#ifndef OUTPUTBUFFER_DEF
+#define OUTPUTBUFFER_DEF
+
+/* Text waiting to be written, length bytes of allocated */
+struct outputBuffer {
+    char *text;
+    size_t length;
+    size_t allocated;
+};
+
+/*
+    Creates an empty output buffer.
+*/
+struct outputBuffer *newOutputBuffer();
+
+/*
+    Appends length bytes of text to the buffer.
+*/
+void appendOutput(struct outputBuffer *b, const char *text, size_t length);
+
+/*
+    Appends one character to the buffer.
+*/
+static inline void appendOutputChar(struct outputBuffer *b, char c) {
+    if (b->length == b->allocated) {
+        appendOutput(b, &c, 1);
+    } else {
+        b->text[b->length++] = c;
+    }
+}
+
+/*
+    Writes all buffered text to the file descriptor, with a single write 
+    call unless the descriptor takes less at once, and empties the buffer.
+*/
+void writeOutput(struct outputBuffer *b, int fd);
+
+/* 
+    Frees the buffer.
+*/
+void freeOutputBuffer(struct outputBuffer *b);
+
+#endif
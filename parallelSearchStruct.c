@@ -0,0 +1,18 @@
+/*
+    Implementation for data structure used in splitting the search of one
+        board over several threads.
+*/
+/* One independent piece of a parallel board search: a root letter started
+    from one cell. */
+struct searchTask {
+    struct trieNode *root;
+    int cell;
+};
+
+/* Parallel board search, each worker using its own context's scratch. */
+struct parallelSearch {
+    struct solverContext **contexts;
+    struct problem *p;
+    struct searchTask *tasks;
+    int taskCount;
+};
@@ -0,0 +1,21 @@
+/*
+    Implementation for data structure used in walking every path of a 
+        board, or the paths through one changed cell.
+*/
+/* A changed cell's paths with its current letter and with the new one */
+#define WALK_SIDES 2
+
+/* Walk over the paths of a board, or over those through one changed cell. */
+struct pathWalk {
+    /* The index's word prefixes spelled backwards, and the frames of the 
+        prefix grown so far from the changed cell, which comes first. */
+    struct prefixTree *reversePrefixes;
+    struct searchFrame *backFrames;
+    char *board;
+    /* Codes of the changed cell's current and new letters */
+    char letters[WALK_SIDES];
+    /* Receive the paths with each letter */
+    wordConsumer consumers[WALK_SIDES];
+    /* The letter being walked */
+    int side;
+};
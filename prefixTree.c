@@ -8,101 +8,241 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <sys/mman.h>
 
 #define PART_D 2
 #define DOUBLE 2
+/* Number of nodes to allocate space for initially */
+#define INITIALNODEALLOCATION 64
 
-/* Frees tree recursively */
-static void recursiveFreeTree(struct prefixTree *t);
+/* Appends a new node to the pool and returns its index */
+static int newNode(struct prefixTree *t, char letter);
+
+/* Numbers words below node recursively, returns how many there are */
+static int recursiveNumberWords(struct prefixTree *t, int node, 
+                                char **dictWords, char **wordList, int *rank);
+
+/* Reorders the pool so the children of every node are consecutive */
+static void layoutChildRuns(struct prefixTree *t);
 
 /*******************************************************/
 /*
-    Creates new tree.
+    Creates new tree spelling words in the codes of the given alphabet.
 */
-struct prefixTree *newPrefixTree(){
-    /* Structure of the prefix tree includes a dummy node. */
+struct prefixTree *newPrefixTree(const struct alphabet *a){
     struct prefixTree *retTree = (struct prefixTree *) 
         malloc(sizeof(struct prefixTree));
     assert(retTree);
-    retTree->child = (struct prefixTree **) malloc(sizeof(struct prefixTree *) 
-                                                   * MAX_CHAR);
-    assert(retTree->child);
-    memset(retTree->child, 0, sizeof(struct prefixTree *) * MAX_CHAR);
-    
-    /* Initialise the tree */
-    retTree->word = NULL; 
-    retTree->numChild = 0;
-    retTree->isEnd = false;
-    retTree->markedWord = false;
-    retTree->isEndB = false;
+    retTree->nodes = (struct trieNode *) malloc(sizeof(struct trieNode) * 
+                                                INITIALNODEALLOCATION);
+    assert(retTree->nodes);
+    retTree->nodeAllocated = INITIALNODEALLOCATION;
+    retTree->nodeCount = 0;
+    retTree->wordPool = NULL;
+    retTree->wordOffsets = NULL;
+    retTree->wordCount = 0;
+    retTree->maxWordLength = 0;
+    retTree->alphabet = *a;
+    retTree->mapping = NULL;
+    retTree->mappingSize = 0;
+
+    /* Structure of the prefix tree includes a dummy node. */
+    newNode(retTree, NULL_CHAR);
     return retTree;
 }
 
 /*
-    Adds word to prefix tree.
+    Appends a new node to the pool and returns its index.
+*/
+static int newNode(struct prefixTree *t, char letter) {
+    if (t->nodeCount >= t->nodeAllocated) {
+        t->nodes = (struct trieNode *) realloc(t->nodes, 
+            sizeof(struct trieNode) * t->nodeAllocated * DOUBLE);
+        assert(t->nodes);
+        t->nodeAllocated *= DOUBLE;
+    }
+    struct trieNode *n = &t->nodes[t->nodeCount];
+
+    /* Initialise the node */
+    n->letter = letter;
+    n->numChild = 0;
+    n->isEnd = false;
+    n->wordId = NO_WORD;
+    n->wordsBefore = 0;
+    n->firstChild = NO_NODE;
+    n->nextSibling = NO_NODE;
+    return t->nodeCount++;
+}
+
+/*
+    Adds word to prefix tree, one node per letter code. Duplicate words keep
+    the first index given.
 */
-struct prefixTree *addWordToTree(struct prefixTree *pt, char *word){
-    struct prefixTree *currLevel = pt;
+struct prefixTree *addWordToTree(struct prefixTree *pt, char *word, int wordId){
+    /* Work with indexes since the pool may move while growing */
+    int currLevel = ROOT_NODE;
     int i = 0;
 
     while (word[i]) {
-        char c = word[i];
+        int length = symbolLength(&word[i]);
+        char c = (char) symbolCode(&pt->alphabet, &word[i], length);
+        assert(c != NO_SYMBOL);
+        int prev = NO_NODE;
+        int curr = pt->nodes[currLevel].firstChild;
+
+        /* find letter among children, which are in ascending order */
+        while (curr != NO_NODE && 
+               (unsigned char) pt->nodes[curr].letter < (unsigned char) c) {
+            prev = curr;
+            curr = pt->nodes[curr].nextSibling;
+        }
+
         /* insert new character */
-        if (!currLevel->child[(int) c]) {
-            currLevel->child[(int) c] = newPrefixTree();
-            currLevel->child[(int) c]->word = combineStr(currLevel->word, &c);
-            (currLevel->numChild)++;
-        } 
-        currLevel = currLevel->child[(int) c];
-        i++;
+        if (curr == NO_NODE || pt->nodes[curr].letter != c) {
+            int added = newNode(pt, c);
+            pt->nodes[added].nextSibling = curr;
+            if (prev == NO_NODE) {
+                pt->nodes[currLevel].firstChild = added;
+            } else {
+                pt->nodes[prev].nextSibling = added;
+            }
+            (pt->nodes[currLevel].numChild)++;
+            curr = added;
+        }
+        currLevel = curr;
+        i += length;
     }
     /* when it is last letter in the word */
-    currLevel->isEnd = true;
+    if (!pt->nodes[currLevel].isEnd) {
+        pt->nodes[currLevel].isEnd = true;
+        pt->nodes[currLevel].wordId = wordId;
+    }
     return pt;
 }
 
-/* 
-    Convert single character to a string.
+/*
+    Numbers the words of a fully built tree in the order of their letter 
+    codes, which is lexicographic, and fills its word list, then lays its 
+    children out in runs.
 */
-char *getStr(char *c) {
-    char *str = (char *) malloc(DOUBLE * (sizeof(char)));
-    assert(str);
-    str[0] = *c;
-    str[1] = NULL_CHAR;
-    return str;
+void numberTreeWords(struct prefixTree *t, char **dictWords) {
+    int rank = 0;
+    int count = 0;
+    for (int i = 0; i < t->nodeCount; i++) {
+        if (t->nodes[i].isEnd) {
+            count++;
+        }
+    }
+    char **wordList = (char **) malloc(sizeof(char *) * (count + 1));
+    assert(wordList);
+    int numbered = recursiveNumberWords(t, ROOT_NODE, dictWords, wordList, 
+                                        &rank);
+    assert(numbered == count);
+    setWordPool(t, wordList, count);
+    free(wordList);
+    layoutChildRuns(t);
 }
 
-/* 
-    Combine two strings to a new memory space.
+/*
+    Reorders the pool breadth first, so the children of every node are one
+    run of consecutive nodes in ascending letter order, like DAWG edges.
+    Nodes are copied whole, so word numbering is unchanged.
 */
-char *combineStr(char *p1, char *p2) {
-    p2 = getStr(p2);
-    char *str = (char*)malloc((strlen(p1) + DOUBLE) * sizeof(char));
-    strcpy(str, p1);
-    strcat(str, p2);
-    free(p2);
-    return str;
+static void layoutChildRuns(struct prefixTree *t) {
+    struct trieNode *nodes = (struct trieNode *) 
+        malloc(sizeof(struct trieNode) * t->nodeCount);
+    assert(nodes);
+    nodes[ROOT_NODE] = t->nodes[ROOT_NODE];
+    int placed = 1;
+
+    /* nodes already placed are visited in order, placing their children */
+    for (int i = 0; i < placed; i++) {
+        int run = placed;
+        for (int c = nodes[i].firstChild; c != NO_NODE; 
+             c = t->nodes[c].nextSibling) {
+            nodes[placed] = t->nodes[c];
+            nodes[placed].nextSibling = placed + 1;
+            placed++;
+        }
+        if (placed > run) {
+            nodes[i].firstChild = run;
+            nodes[placed - 1].nextSibling = NO_NODE;
+        }
+    }
+    assert(placed == t->nodeCount);
+    free(t->nodes);
+    t->nodes = nodes;
+    t->nodeAllocated = t->nodeCount;
 }
 
-/* 
-    Frees tree by calling a recursive function. 
+/*
+    Numbers words below node in pre-order, so a word comes before its 
+    extensions, and returns how many there are.
 */
-void freeTree(struct prefixTree *t) {
-    recursiveFreeTree(t);
+static int recursiveNumberWords(struct prefixTree *t, int node, 
+                                char **dictWords, char **wordList, int *rank) {
+    int below = 0;
+    if (t->nodes[node].isEnd) {
+        wordList[(*rank)++] = dictWords[t->nodes[node].wordId];
+    }
+    for (int c = t->nodes[node].firstChild; c != NO_NODE; 
+         c = t->nodes[c].nextSibling) {
+        t->nodes[c].wordsBefore = below;
+        below += recursiveNumberWords(t, c, dictWords, wordList, rank);
+    }
+    return below + (t->nodes[node].isEnd ? 1 : 0);
 }
 
-/* 
-    Frees tree recursively 
+/*
+    Copies given words, already in word number order, into the word pool, 
+    and measures the longest of them in letters.
 */
-static void recursiveFreeTree(struct prefixTree *t) {
-    for (int i = 0; i < MAX_CHAR; i++) {
-        if (t->child[i]) {
-            recursiveFreeTree(t->child[i]);
-            t->child[i] = NULL;
+void setWordPool(struct prefixTree *t, char **words, int wordCount) {
+    size_t poolSize = 0;
+    int i;
+    for (i = 0; i < wordCount; i++) {
+        poolSize += strlen(words[i]) + 1;
+    }
+    free(t->wordPool);
+    free(t->wordOffsets);
+    t->wordPool = (char *) malloc(poolSize + 1);
+    assert(t->wordPool);
+    t->wordOffsets = (int *) malloc(sizeof(int) * (wordCount + 1));
+    assert(t->wordOffsets);
+
+    int offset = 0;
+    t->maxWordLength = 0;
+    for (i = 0; i < wordCount; i++) {
+        t->wordOffsets[i] = offset;
+        strcpy(t->wordPool + offset, words[i]);
+        offset += strlen(words[i]) + 1;
+        int letters = 0;
+        int length;
+        for (char *c = words[i]; *c; c += length) {
+            length = symbolLength(c);
+            letters++;
         }
+        if (letters > t->maxWordLength) {
+            t->maxWordLength = letters;
+        }
+    }
+    t->wordOffsets[wordCount] = offset;
+    t->wordCount = wordCount;
+}
+
+/* 
+    Frees tree, every node lives in the pool so no traversal is needed. A 
+    tree loaded from an index file is unmapped instead.
+*/
+void freeTree(struct prefixTree *t) {
+    if (t->mapping) {
+        munmap(t->mapping, t->mappingSize);
+        free(t);
+        return;
     }
-    free(t->word);
-    free(t->child);
+    free(t->wordPool);
+    free(t->wordOffsets);
+    free(t->nodes);
     free(t);
 }
 
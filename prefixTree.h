@@ -3,6 +3,8 @@
         data structures and functions.
 */
 #include <stdbool.h>
+#include <stddef.h>
+#include "alphabet.h"
 
 #ifndef PREFIXTREESTRUCT
 #define PREFIXTREESTRUCT
@@ -11,47 +13,169 @@
 #define NULL_CHAR '\0'
 #define DEFAULT_STR ""
 
+/* Index used for a missing child or sibling link */
+#define NO_NODE (-1)
+/* Index of the dummy root node in the node pool */
+#define ROOT_NODE 0
+/* Word ID of a node which does not end a word */
+#define NO_WORD (-1)
+
 struct prefixTree;
+struct trieNode;
 
-/* Data structure for prefix tree */
-struct prefixTree {
-    /* Partial string */
-    char *word;
-    /* Number of its children letters */
-    int numChild;
+/* Data structure for a single node in the prefix tree. The same layout is 
+    used for the edges of a DAWG, where several parents may share one list of 
+    children, so nodes hold nothing specific to a single path or search. */
+struct trieNode {
+    /* Code in the index's alphabet of the letter on the edge leading into 
+        this node, the partial string is the sequence of letters on the path
+        from the root */
+    char letter;
     /* Whether it is last letter in word */
     bool isEnd;
-    /* Whether it is last letter in word for part B */
-    bool isEndB;
-     /* Stores all its children */
-    struct prefixTree **child;
-    /* Whether word in dictionary */
-    bool markedWord;
+    /* Number of its children letters */
+    int numChild;
+    /* Dictionary index of the word ending here while the tree is being built,
+        NO_WORD if not isEnd (unused by DAWG) */
+    int wordId;
+    /* Number of words below the earlier siblings of this node. Words are 
+        numbered in lexicographic order, so the word ending at a node is 
+        number base + wordsBefore where base is accumulated from the root via
+        getChildBase(). */
+    int wordsBefore;
+    /* Pool index of first child, children are kept in ascending letter 
+        order in a run of numChild consecutive nodes, also linked through 
+        nextSibling */
+    int firstChild;
+    /* Pool index of next child of the same parent */
+    int nextSibling;
 };
 
+/* Data structure for prefix tree, all nodes live in one contiguous pool and 
+    refer to each other by index, so node 0 is the dummy root. */
+struct prefixTree {
+    struct trieNode *nodes;
+    int nodeCount;
+    int nodeAllocated;
+    /* Distinct words in lexicographic order, word i being the string at 
+        wordPool + wordOffsets[i] */
+    char *wordPool;
+    int *wordOffsets;
+    int wordCount;
+    /* Letters of the longest word, so no search path is ever longer */
+    int maxWordLength;
+    /* Letters the node letters are codes of, the words of the pool being 
+        in ascending order of their codes */
+    struct alphabet alphabet;
+    /* File mapping holding nodes and words when loaded from an index file,
+        NULL when built in memory */
+    void *mapping;
+    size_t mappingSize;
+};
+
+/* 
+    Returns the root node of the tree. Node pointers are only stable once
+    no more words are being added.
+*/
+static inline struct trieNode *getRoot(struct prefixTree *t) {
+    return &t->nodes[ROOT_NODE];
+}
+
+/*
+    Returns first child of node in ascending letter order, or NULL.
+*/
+static inline struct trieNode *getFirstChild(struct prefixTree *t, 
+                                             struct trieNode *n) {
+    return n->firstChild == NO_NODE ? NULL : &t->nodes[n->firstChild];
+}
+
+/*
+    Returns next sibling of node in ascending letter order, or NULL.
+*/
+static inline struct trieNode *getNextSibling(struct prefixTree *t, 
+                                              struct trieNode *n) {
+    return n->nextSibling == NO_NODE ? NULL : &t->nodes[n->nextSibling];
+}
+
+/*
+    Returns child of node reached through given letter code, or NULL, by 
+    binary search of its run of children.
+*/
+static inline struct trieNode *getChild(struct prefixTree *t, 
+                                        struct trieNode *n, char c) {
+    if (n->numChild == 0) {
+        return NULL;
+    }
+    struct trieNode *run = &t->nodes[n->firstChild];
+    int low = 0;
+    int high = n->numChild;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if ((unsigned char) run[mid].letter < (unsigned char) c) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < n->numChild && run[low].letter == c ? &run[low] : NULL;
+}
+
+/*
+    Returns word with given word number.
+*/
+static inline char *getWord(struct prefixTree *t, int wordNumber) {
+    return t->wordPool + t->wordOffsets[wordNumber];
+}
+
+/*
+    Returns length of word with given word number.
+*/
+static inline int getWordLength(struct prefixTree *t, int wordNumber) {
+    return t->wordOffsets[wordNumber + 1] - t->wordOffsets[wordNumber] - 1;
+}
+
+/*
+    Returns word number of the word ending at node, given the base number 
+    accumulated on the path to it.
+*/
+static inline int getWordNumber(struct trieNode *n, int base) {
+    return base + n->wordsBefore;
+}
+
+/*
+    Returns the base word number to pass on to the children of node.
+*/
+static inline int getChildBase(struct trieNode *n, int base) {
+    return base + n->wordsBefore + (n->isEnd ? 1 : 0);
+}
+
 #endif
 
 /*
-    Creates new tree.
+    Creates new tree spelling words in the codes of the given alphabet.
 */
-struct prefixTree *newPrefixTree();
+struct prefixTree *newPrefixTree(const struct alphabet *a);
 
 /*
-    Adds words into tree.
+    Adds words into tree, tagging its last node with given dictionary index.
+    Every letter of the word must be in the tree's alphabet.
 */
-struct prefixTree *addWordToTree(struct prefixTree *pt, char *word);
+struct prefixTree *addWordToTree(struct prefixTree *pt, char *word, int wordId);
 
 /*
-    Combines 2 strings.
+    Numbers the words of a fully built tree in lexicographic order and fills
+    its word list, dictWords being the words the indexes in addWordToTree 
+    refer to.
 */
-char *combineStr(char *p1, char *p2);
+void numberTreeWords(struct prefixTree *t, char **dictWords);
+
+/*
+    Copies given words, already in word number order, into the word pool, 
+    and measures the longest of them.
+*/
+void setWordPool(struct prefixTree *t, char **words, int wordCount);
 
 /* 
     Frees tree.
 */
 void freeTree(struct prefixTree *t);
-
-/*
-    Converts character into string.
-*/
-char *getStr(char *c);
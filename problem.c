@@ -16,393 +16,2063 @@
 #include "problem.h"
 #include "problemStruct.c"
 #include "solutionStruct.c"
+#include "solverContextStruct.c"
+#include "parallelSearchStruct.c"
+#include "bestSearchStruct.c"
+#include "pathWalkStruct.c"
+#include "boardLettersStruct.c"
+#include "tiledSearchStruct.c"
+#include "searchFrameStruct.c"
+#include "searchRulesStruct.c"
+#include "hintSessionStruct.c"
 #include "prefixTree.h"
+#include "dawg.h"
+#include "bitset.h"
+#include "letterScan.h"
+#include "threadPool.h"
+#include "outputBuffer.h"
+#include "scoring.h"
 
-/* Number of words to allocate space for initially. */
-#define INITIALWORDSALLOCATION 64
 #define DEFAULT_STR ""
 #define NUM_1 1
 #define NUM_2 2
 #define NUM_3 3
 
+#define DOUBLE 2
+/* Number of found words to allocate space for initially */
+#define INITIAL_HITS 64
+/* Partial string lengths a hint session has room for initially */
+#define INITIAL_HINT_LEVELS 16
+
+/* Bit of a letter code in a part D used letter mask, shared by codes 64 
+	apart */
+static inline uint64_t usedLetterBit(char letter) {
+	return (uint64_t) 1 << ((unsigned char) letter & 63);
+}
+
+/* A byte repeated in every byte of a word, and the bits below the top 
+	bit of every byte */
+#define EVERY_BYTE 0x0101010101010101ULL
+#define LOW_BYTE_BITS 0x7F7F7F7F7F7F7F7FULL
+
+/* The top bit of every byte of codes equal to the letter code. A byte's 
+	low bits added to LOW_BYTE_BITS carry into its top bit unless they are 
+	zero, so no byte borrows from its neighbour. */
+static inline uint64_t matchingBytes(uint64_t codes, char letter) {
+	uint64_t x = codes ^ (EVERY_BYTE * (unsigned char) letter);
+	uint64_t y = ((x & LOW_BYTE_BITS) + LOW_BYTE_BITS) | x;
+	return ~(y | LOW_BYTE_BITS);
+}
+
+/* The bytes set in bytes whose neighbours in the list are not on the 
+	path, checked one at a time as few neighbours match a letter */
+static inline uint64_t unvisitedBytes(struct solverContext *ctx, 
+	const int *around, uint64_t bytes) {
+	uint64_t bits = bytes;
+	while (bits) {
+		int k = takeLowestBit(&bits) / CHAR_BIT;
+		if (testBit(ctx->visited, around[k])) {
+			bytes &= ~((uint64_t) 1 << (k * CHAR_BIT + CHAR_BIT - 1));
+		}
+	}
+	return bytes;
+}
+
+/* Boards with more cells a side are searched in tiles */
+#define HUGE_BOARD_DIMENSION 64
+/* Cells a side of the window a tile is searched on, halo included, and 
+	the fewest cells a side of a tile */
+#define TILE_WINDOW 48
+#define MIN_TILE 8
+/* Window cells off the board hold a byte no letter is coded from */
+#define OFF_BOARD NULL_CHAR
+
 struct problem;
 struct solution;
 
-/* Sets up a solution for the given problem. */
-struct solution *newSolution(struct problem *problem);
+/* Sets up a solution for the given problem. */
+struct solution *newSolution(struct problem *problem, struct prefixTree *t);
+
+/* Creates a solver context for one search of the problem's board, its
+	index built only from the words that board could hold. */
+static struct solverContext *newBoardSolverContext(struct problem *p);
+/* Records the letters of the problem's board and which are neighbours. */
+static void countBoardLetters(struct problem *p, struct boardLetters *b);
+/* Whether the board's letters and neighbours could spell the word. */
+static bool wordFitsBoard(const char *word, const struct boardLetters *b);
+
+/* Gives the solution the index the context built, if it did. */
+static void keepIndex(struct solverContext *ctx, struct solution *s);
+
+/* Reads the given board file into the problem. */
+static void readBoard(struct problem *p, FILE *boardFile);
+/* Returns the board byte standing for the UTF-8 letter of length bytes. */
+static char wideBoardLetter(struct problem *p, const char *text, int length);
+/* Returns the code in the alphabet of the letter a board byte stands for, 
+	folded to lower case. */
+static int boardLetterCode(struct problem *p, const struct alphabet *a, 
+	unsigned char letter);
+
+/* Solves the problem with a parallel board solver on p->threads threads. */
+static struct solution *solveProblemParallel(struct problem *p, 
+	struct solution *(*solveBoard)(struct solverContext **, int, 
+								   struct problem *));
+
+/* Runs the tasks of a parallel search, one per root letter and cell. */
+static struct solution *searchBoardParallel(struct solverContext **contexts,
+	int threadCount, struct problem *p, 
+	void (*searchTask)(void *, int, int));
+/* Runs a single task of a parallel search on a worker thread. */
+static void searchTaskA(void *arg, int taskIndex, int worker);
+static void searchTaskD(void *arg, int taskIndex, int worker);
+
+/* Merges the words found by every context into the first one. */
+static void mergeFound(struct solverContext **contexts, int count);
+
+/* Whether the board is better searched in tiles. */
+static bool searchInTiles(struct problem *p, struct prefixTree *t);
+/* Sizes the tiles of a board's search for the index's longest word. */
+static bool sizeTiles(struct tiledSearch *search, struct problem *p, 
+	struct prefixTree *t);
+/* Runs the tasks of a tiled search of a huge board, one per tile. */
+static struct solution *searchBoardTiled(struct solverContext **contexts, 
+	int threadCount, struct problem *p, void (*searchTile)(void *, int, int));
+/* Searches the paths starting in one tile on a worker thread. */
+static void searchTileA(void *arg, int tileIndex, int worker);
+static void searchTileD(void *arg, int tileIndex, int worker);
+/* Readies the worker's context for a tile's window, returning the window 
+	cells inside the tile. */
+static uint64_t *loadTile(struct tiledSearch *search, int tileIndex, 
+	int worker);
+
+/* Hands a word number to the consumer the first time the context's current
+	search finds it. */
+static inline void recordWord(struct solverContext *ctx, int w, int depth);
+
+/* Appends a word number to the context's hits. */
+static void pushHit(struct solverContext *ctx, int w);
+static bool appendHit(void *arg, int wordNumber, const char *word, 
+	const int *path, int pathLength);
+
+/* Part B hint session levels and the search for their follow letters. */
+static void appendHintCode(struct hintSession *s, char code);
+static void growHintLevels(struct hintSession *s, int levels);
+static void findFollowLetters(struct hintSession *s, int level, bool *follow);
+static bool completesWord(struct hintSession *s, struct trieNode *t, 
+	int depth);
+static void growHintScratch(struct hintSession *s, int depth);
+/* Sets to the cells holding letter next to some cell of from. */
+static bool stepCells(struct solverContext *ctx, uint64_t *from, char letter, 
+	uint64_t *to);
+static bool anyCell(uint64_t *cells, int words);
+static int comparePartialStrings(const void *s1, const void *s2);
+
+/* Searches the board from every root letter. */
+static void searchBoardA(struct solverContext *ctx, struct problem *p);
+static void searchBoardD(struct solverContext *ctx);
+/* Consumer adding each word's score to the board score given as arg */
+static bool addScoredHit(void *arg, int wordNumber, const char *word, 
+	const int *path, int pathLength);
+/* Rule hooks of the best word search. */
+static inline bool reachBest(struct solverContext *ctx, 
+	struct searchFrame *frame);
+static inline struct trieNode *nextChildBest(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child);
+/* Rule hooks of the path walks, forwards and backwards from a changed 
+	cell. */
+static inline bool reachPath(struct solverContext *ctx, 
+	struct searchFrame *frame);
+static inline bool reachBack(struct solverContext *ctx, 
+	struct searchFrame *frame);
+static inline struct trieNode *nextChildBack(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child);
+
+/* Stores the neighbours of every cell for boards of the given dimension. */
+static void buildAdjacency(struct solverContext *ctx, int dimension);
+/* Readies the context's board bitsets for the problem's board. */
+static void prepareBoard(struct solverContext *ctx, struct problem *p);
+/* Starts a new set of found words in the context. */
+static void startSearch(struct solverContext *ctx);
+
+/* Iterative depth-first search from one cell under one part's rules, 
+	inlined into each part's search so its rules are direct calls. */
+static inline __attribute__((always_inline)) void searchPaths(
+	struct solverContext *ctx, const struct searchRules *rules, 
+	struct searchFrame *frames, struct trieNode *t, int base, int cell, 
+	int depth);
+/* Readies a frame reached by the search, returning whether to go past it. */
+static inline bool enterFrame(struct solverContext *ctx, 
+	const struct searchRules *rules, struct searchFrame *f);
+/* Moves a frame's cursor to the next neighbours holding a child's letter. */
+static inline bool nextCells(struct solverContext *ctx, 
+	const struct searchRules *rules, struct searchFrame *f);
+/* Rule hooks of the search of each part. */
+static inline bool reachWord(struct solverContext *ctx, 
+	struct searchFrame *frame);
+static inline bool reachB(struct solverContext *ctx, 
+	struct searchFrame *frame);
+static inline struct trieNode *nextChildA(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child);
+static inline struct trieNode *nextChildB(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child);
+static inline struct trieNode *nextChildD(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child);
+
+/* Part A paths never repeat a cell, part D paths never repeat a letter so 
+	never a cell either, and part B paths may repeat both. */
+static const struct searchRules rulesA = {reachWord, nextChildA, true};
+static const struct searchRules rulesB = {reachB, nextChildB, false};
+static const struct searchRules rulesD = {reachWord, nextChildD, false};
+/* The best word search skips children which cannot beat the best word, 
+	path walks hand over every path rather than every word, and the walk 
+	back from a changed cell follows the index's prefixes read backwards. */
+static const struct searchRules rulesBest = {reachBest, nextChildBest, true};
+static const struct searchRules rulesWalk = {reachPath, nextChildA, true};
+static const struct searchRules rulesBack = {reachBack, nextChildBack, true};
+
+/* Part A search on boards of at most 64 cells. */
+static void exploreSmallA(struct solverContext *ctx, struct trieNode *t, 
+	int base, int cell, uint64_t visited, int depth);
+
+/* Solver context *************************************************************/
+/*
+	Creates a solver context from the given problem's dictionary, or from its
+	prebuilt index if one was given with useDictionaryIndex.
+*/
+struct solverContext *newSolverContext(struct problem *dictionary){
+	if(dictionary->sharedIndex){
+		return newSolverContextFromIndex(dictionary->sharedIndex);
+	}
+	struct solverContext *ctx = 
+		newSolverContextFromIndex(buildDictionaryIndex(dictionary));
+	ctx->ownsIndex = true;
+	return ctx;
+}
+
+/*
+	Creates a solver context for a single search of the problem's board. 
+	Words that board cannot spell are left out of the index it builds: those
+	with a letter it lacks, with two letters in a row that are never 
+	neighbours on it or, unless part B may reuse cells, using a letter more 
+	often than the board holds it. A prebuilt index is searched whole.
+*/
+static struct solverContext *newBoardSolverContext(struct problem *p){
+	struct boardLetters b;
+	countBoardLetters(p, &b);
+	if(p->sharedIndex || b.unfiltered){
+		return newSolverContext(p);
+	}
+	char **words = (char **) malloc(sizeof(char *) * (p->wordCount + 1));
+	assert(words);
+	int wordCount = 0;
+	for(int i = 0; i < p->wordCount; i++){
+		if(wordFitsBoard(p->words[i], &b)){
+			words[wordCount++] = p->words[i];
+		}
+	}
+	struct problem boardWords = *p;
+	boardWords.words = words;
+	boardWords.wordCount = wordCount;
+	struct solverContext *ctx = 
+		newSolverContextFromIndex(buildDictionaryIndex(&boardWords));
+	ctx->ownsIndex = true;
+	free(words);
+	return ctx;
+}
+
+/*
+	Counts the cells holding each letter of the problem's board and records 
+	which letters are neighbours somewhere on it.
+*/
+static void countBoardLetters(struct problem *p, struct boardLetters *b){
+	int dimension = p->dimension;
+	memset(b, 0, sizeof(struct boardLetters));
+	b->reuse = p->part == PART_B;
+	for(int i = 0; i < dimension * dimension; i++){
+		unsigned letter = tolower((unsigned char) p->boardFlat[i]) - 'a';
+		if(letter >= BOARD_LETTERS){
+			b->unfiltered = true;
+			return;
+		}
+		b->counts[letter]++;
+	}
+	for(int row = 0; row < dimension; row++){
+		for(int col = 0; col < dimension; col++){
+			unsigned letter = 
+				tolower((unsigned char) p->board[row][col]) - 'a';
+			for(int r = row - 1; r <= row + 1; r++){
+				for(int c = col - 1; c <= col + 1; c++){
+					if(r < 0 || r >= dimension || c < 0 || c >= dimension ||
+					   (r == row && c == col)){
+						continue;
+					}
+					b->adjacent[letter] |= (uint32_t) 1 << 
+						(tolower((unsigned char) p->board[r][c]) - 'a');
+				}
+			}
+		}
+	}
+}
+
+/*
+	Checks the word against the board's letters: each letter must be on the
+	board and a neighbour of the one before it, and unless cells may be 
+	reused, no letter may be used more often than the board holds it.
+*/
+static bool wordFitsBoard(const char *word, const struct boardLetters *b){
+	int used[BOARD_LETTERS];
+	bool repeated = false;
+	uint32_t seen = 0;
+	unsigned previous = BOARD_LETTERS;
+	for(const char *c = word; *c; c++){
+		unsigned letter = (unsigned char) *c - 'a';
+		if(letter >= BOARD_LETTERS || b->counts[letter] == 0){
+			return false;
+		}
+		if(previous < BOARD_LETTERS && 
+		   !(b->adjacent[previous] & ((uint32_t) 1 << letter))){
+			return false;
+		}
+		repeated = repeated || (seen & ((uint32_t) 1 << letter));
+		seen |= (uint32_t) 1 << letter;
+		previous = letter;
+	}
+	if(!repeated || b->reuse){
+		return true;
+	}
+	/* Only words repeating a letter can run out of it */
+	memset(used, 0, sizeof(used));
+	for(const char *c = word; *c; c++){
+		if(++used[*c - 'a'] > b->counts[*c - 'a']){
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+	Creates a solver context searching the given index, which stays owned by
+	the caller and is never changed by a search. Contexts sharing one index 
+	can be used from different threads.
+*/
+struct solverContext *newSolverContextFromIndex(struct prefixTree *index){
+	struct solverContext *ctx = (struct solverContext *) 
+		malloc(sizeof(struct solverContext));
+	assert(ctx);
+	ctx->index = index;
+	ctx->ownsIndex = false;
+	ctx->hitAllocated = INITIAL_HITS;
+	ctx->hitCount = 0;
+	ctx->hits = (int *) malloc(sizeof(int) * ctx->hitAllocated);
+	ctx->foundStamp = (uint32_t *) calloc(index->wordCount + 1, 
+										  sizeof(uint32_t));
+	assert(ctx->hits && ctx->foundStamp);
+	ctx->generation = 0;
+	ctx->consumer = appendHit;
+	ctx->consumerArg = ctx;
+	ctx->stopped = false;
+	ctx->searchState = NULL;
+	ctx->path = NULL;
+	/* no search path is longer than the longest word */
+	ctx->frames = (struct searchFrame *) malloc(sizeof(struct searchFrame) * 
+												(index->maxWordLength + 1));
+	assert(ctx->frames);
+	ctx->boardWords = 0;
+	ctx->visited = NULL;
+	ctx->letterMask = NULL;
+	ctx->heldLetterCount = 0;
+	ctx->prefixEnd = NULL;
+	ctx->prefixEndSize = 0;
+	ctx->partialCodes = NULL;
+	ctx->partialLength = 0;
+	ctx->neighbours = NULL;
+	ctx->neighbourMask = NULL;
+	ctx->neighbourCodes = NULL;
+	ctx->adjacencyDimension = 0;
+	return ctx;
+}
+
+/*
+	Frees the given solver context, and its index if the context built it.
+*/
+void freeSolverContext(struct solverContext *ctx){
+	if(ctx){
+		if(ctx->ownsIndex){
+			freeTree(ctx->index);
+		}
+		free(ctx->hits);
+		free(ctx->foundStamp);
+		free(ctx->path);
+		free(ctx->frames);
+		free(ctx->visited);
+		free(ctx->prefixEnd);
+		free(ctx->partialCodes);
+		free(ctx->letterMask);
+		free(ctx->neighbours);
+		free(ctx->neighbourMask);
+		free(ctx->neighbourCodes);
+		free(ctx);
+	}
+}
+
+/*
+	Readies the context scratch for a search of the given board, coding its
+	pieces and any partial string in the letter codes of the index. Pieces 
+	are folded to lower case as they are coded, the board itself is left as
+	it is.
+*/
+static void prepareSearch(struct solverContext *ctx, struct problem *p){
+	const struct alphabet *alphabet = &ctx->index->alphabet;
+	prepareBoard(ctx, p);
+	startSearch(ctx);
+	ctx->partialLength = 0;
+	if (p->partialString) {
+		/* a partial string has no more letters than bytes */
+		if (p->partialSize + 1 > ctx->prefixEndSize) {
+			free(ctx->prefixEnd);
+			free(ctx->partialCodes);
+			ctx->prefixEnd = (bool *) malloc(sizeof(bool) * 
+											 (p->partialSize + 1));
+			ctx->partialCodes = (char *) malloc(sizeof(char) * 
+												(p->partialSize + 1));
+			assert(ctx->prefixEnd && ctx->partialCodes);
+			ctx->prefixEndSize = p->partialSize + 1;
+		}
+		memset(ctx->prefixEnd, false, sizeof(bool) * (p->partialSize + 1));
+		memset(ctx->followFound, false, sizeof(bool) * MAX_CHAR);
+		/* letters missing from the alphabet are coded NO_SYMBOL, which no 
+			node has */
+		int length;
+		for (char *c = p->partialString; *c; c += length) {
+			length = symbolLength(c);
+			ctx->partialCodes[ctx->partialLength++] = 
+				(char) symbolCode(alphabet, c, length);
+		}
+		ctx->partialCodes[ctx->partialLength] = (char) NO_SYMBOL;
+	}
+}
+
+/*
+	Sizes the context's board bitsets for the board of the given problem and
+	fills in the cells of each letter code it holds.
+*/
+static void prepareBoard(struct solverContext *ctx, struct problem *p){
+	int cells = p->dimension * p->dimension;
+	const struct alphabet *alphabet = &ctx->index->alphabet;
+	buildAdjacency(ctx, p->dimension);
+	memset(ctx->visited, 0, sizeof(uint64_t) * ctx->boardWords);
+	/* only the letters of the last board have cells to clear */
+	for (int i = 0; i < ctx->heldLetterCount; i++) {
+		memset(&ctx->letterMask[(unsigned char) ctx->heldLetters[i] * 
+								ctx->boardWords], 0, 
+			   sizeof(uint64_t) * ctx->boardWords);
+	}
+	/* board letters of either case share the code of the lower case one */
+	bool held[MAX_CHAR] = {false};
+	ctx->heldLetterCount = 0;
+	for (int i = 0; i < cells; i++) {
+		unsigned char letter = p->boardFlat[i];
+		if (held[letter]) {
+			continue;
+		}
+		held[letter] = true;
+		int code = boardLetterCode(p, alphabet, letter);
+		ctx->boardCodes[letter] = code;
+		if (code != NO_SYMBOL) {
+			/* one vector scan of the board per letter it holds */
+			scanLetterCells(p->boardFlat, cells, (char) letter, 
+							&ctx->letterMask[code * ctx->boardWords]);
+			ctx->heldLetters[ctx->heldLetterCount++] = code;
+		}
+	}
+	for (int i = 0; i < cells; i++) {
+		int *around = &ctx->neighbours[i * MAX_NEIGHBOURS];
+		uint64_t codes = 0;
+		for (int k = 0; k < MAX_NEIGHBOURS && around[k] != NO_CELL; k++) {
+			codes |= (uint64_t) ctx->boardCodes[
+				(unsigned char) p->boardFlat[around[k]]] << (k * CHAR_BIT);
+		}
+		ctx->neighbourCodes[i] = codes;
+	}
+}
+
+/*
+	Starts a new search in the context, with no words found yet and found 
+	words collected as hits.
+*/
+static void startSearch(struct solverContext *ctx){
+	ctx->hitCount = 0;
+	ctx->consumer = appendHit;
+	ctx->consumerArg = ctx;
+	ctx->stopped = false;
+	if (++ctx->generation == 0) {
+		/* stamps wrapped around, so old ones could match again */
+		memset(ctx->foundStamp, 0, sizeof(uint32_t) * ctx->index->wordCount);
+		ctx->generation = 1;
+	}
+}
+
+/*
+	Hands the index the context built over to the solution, whose word 
+	numbers refer to it, so the context can be freed first.
+*/
+static void keepIndex(struct solverContext *ctx, struct solution *s){
+	if (ctx->ownsIndex) {
+		ctx->ownsIndex = false;
+		s->ownsIndex = true;
+	}
+}
+
+/* New solutions **************************************************************/
+/* 
+	Sets up a solution for the given problem searched with the given index.
+*/
+struct solution *newSolution(struct problem *problem, struct prefixTree *t){
+	struct solution *s = (struct solution *) malloc(sizeof(struct solution));
+	assert(s);
+	s->foundWordCount = 0;
+	s->wordNumbers = NULL;
+	s->index = t;
+	s->ownsIndex = false;
+	s->foundLetterCount = 0;
+	s->followLetters = NULL;
+	if (problem->part == PART_B) {
+		s->followLetters = (char *) malloc(sizeof(char) * 
+										   (MAX_CHAR + problem->partialSize));
+		assert(s->followLetters);
+	}
+	return s;
+}
+
+/* Iterative search ***********************************************************/
+/*
+	Depth-first search from tree node t at the given board cell, following 
+	the rules of one part. The path is kept in frames, each with its node, 
+	cell and the cursor over its children and the neighbours holding their 
+	letters, so going a letter deeper pushes a frame instead of recursing. 
+	base is the word number base accumulated on the path to t, and depth the
+	length of the path before cell, whose frames are left as they are. 
+	Searches start from a root child at depth 0 in the context's frames.
+*/
+static inline void searchPaths(struct solverContext *ctx, 
+	const struct searchRules *rules, struct searchFrame *frames, 
+	struct trieNode *t, int base, int cell, int depth) {
+	int start = depth;
+	frames[depth].node = t;
+	frames[depth].base = base;
+	frames[depth].cell = cell;
+	frames[depth].depth = depth;
+	frames[depth].used = usedLetterBit(t->letter);
+	if (!enterFrame(ctx, rules, &frames[depth])) {
+		return;
+	}
+
+	while (depth >= start) {
+		struct searchFrame *f = &frames[depth];
+		if (f->next) {
+			/* go on to the next cell holding the child's letter */
+			struct searchFrame *g = f + 1;
+			assert(depth + 1 <= ctx->index->maxWordLength);
+			g->node = f->child;
+			g->base = f->childBase;
+			g->cell = f->around[takeLowestBit(&f->next) / CHAR_BIT];
+			g->depth = depth + 1;
+			g->used = f->used | usedLetterBit(f->child->letter);
+			if (enterFrame(ctx, rules, g)) {
+				depth++;
+			} else if (ctx->stopped) {
+				break;
+			}
+		} else if (!nextCells(ctx, rules, f)) {
+			if (rules->distinctCells) {
+				ctx->visited[f->cell / BITS_PER_WORD] &= 
+					~((uint64_t) 1 << (f->cell % BITS_PER_WORD));
+			}
+			depth--;
+		}
+	}
+
+	/* a stopped search leaves the cells of its path visited */
+	for (; depth >= start && rules->distinctCells; depth--) {
+		ctx->visited[frames[depth].cell / BITS_PER_WORD] &= 
+			~((uint64_t) 1 << (frames[depth].cell % BITS_PER_WORD));
+	}
+}
+
+/*
+	Hands the frame's node to the part's rules as the path reaches it and 
+	moves its cursor to the first neighbours of its cell holding a child's 
+	letter. Returns false if the path goes no further, or the search has 
+	stopped, leaving the frame off the path.
+*/
+static inline bool enterFrame(struct solverContext *ctx, 
+	const struct searchRules *rules, struct searchFrame *f) {
+	/* a stopped search reaches no more nodes, so no more words are handed 
+		to its consumer */
+	if (ctx->stopped || !rules->reach(ctx, f) || ctx->stopped) {
+		return false;
+	}
+	f->childBase = getChildBase(f->node, f->base);
+	f->around = &ctx->neighbours[f->cell * MAX_NEIGHBOURS];
+	f->codes = ctx->neighbourCodes[f->cell];
+	f->child = NULL;
+	if (!f->codes || !nextCells(ctx, rules, f)) {
+		return false;
+	}
+	if (rules->distinctCells) {
+		setBit(ctx->visited, f->cell);
+	}
+	return true;
+}
+
+/*
+	Moves the frame's cursor on to the next child with neighbours of its 
+	cell holding the child's letter, less those on the path if the part's 
+	paths never repeat a cell. Returns false once no child is left.
+*/
+static inline bool nextCells(struct solverContext *ctx, 
+	const struct searchRules *rules, struct searchFrame *f) {
+	struct trieNode *child = f->child;
+	uint64_t next;
+	do {
+		child = rules->nextChild(ctx, f, child);
+		if (!child) {
+			return false;
+		}
+		next = matchingBytes(f->codes, child->letter);
+		if (next && rules->distinctCells) {
+			next = unvisitedBytes(ctx, f->around, next);
+		}
+	} while (!next);
+	f->child = child;
+	f->next = next;
+	return true;
+}
+
+/*
+	Part A and D rule handing the word the path spells, if any, to the 
+	context's consumer.
+*/
+static inline bool reachWord(struct solverContext *ctx, 
+	struct searchFrame *frame) {
+	ctx->path[frame->depth] = frame->cell;
+	if (frame->node->isEnd) {
+		recordWord(ctx, getWordNumber(frame->node, frame->base), frame->depth);
+	}
+	return frame->node->numChild > 0;
+}
+
+/*
+	Part A rule trying every child in turn.
+*/
+static inline struct trieNode *nextChildA(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child) {
+	return child ? getNextSibling(ctx->index, child) : 
+				   getFirstChild(ctx->index, frame->node);
+}
+
+/* Part A ********************************************************************/
+/*
+	Solves the given problem according to part A's definitions
+	and places the solution output into a returned solution value.
+*/
+struct solution *solveProblemA(struct problem *p){
+	if (p->threads > 1 || p->dimension > HUGE_BOARD_DIMENSION) {
+		return solveProblemParallel(p, solveBoardParallelA);
+	}
+	struct solverContext *ctx = newBoardSolverContext(p);
+	struct solution *s = solveBoardA(ctx, p);
+	keepIndex(ctx, s);
+	freeSolverContext(ctx);
+	return s;
+}
+
+/*
+	Solves the board of the given problem according to part A's definitions 
+	with the context's dictionary.
+*/
+struct solution *solveBoardA(struct solverContext *ctx, struct problem *p){
+	if (searchInTiles(p, ctx->index)) {
+		return searchBoardTiled(&ctx, 1, p, searchTileA);
+	}
+	struct prefixTree *t = ctx->index;
+	struct solution *s = newSolution(p, t);
+
+	prepareSearch(ctx, p);
+	searchBoardA(ctx, p);
+
+	/* Get all the solutions in lexicographic order */
+	 collectSolutions(t, ctx->hits, ctx->hitCount, s);
+	 return s;
+}
+
+/*
+	Searches the board of the given problem according to part A's 
+	definitions, handing each word to consumer as soon as it is first found.
+*/
+bool streamBoardA(struct solverContext *ctx, struct problem *p, 
+	wordConsumer consumer, void *arg){
+	prepareSearch(ctx, p);
+	ctx->consumer = consumer;
+	ctx->consumerArg = arg;
+	searchBoardA(ctx, p);
+	return !ctx->stopped;
+}
+
+/*
+	Searches the board for part A from every cell holding a root letter, 
+	until the consumer stops the search.
+*/
+static void searchBoardA(struct solverContext *ctx, struct problem *p){
+	struct prefixTree *t = ctx->index;
+	struct trieNode *c;
+	int base = 0;
+
+	/* perform depth-first search by looping through all words in prefix tree */
+	for (c = getFirstChild(t, getRoot(t)); c && !ctx->stopped; 
+		 c = getNextSibling(t, c)) {
+
+		/* Starts from every board cell holding the first tree char */
+		uint64_t *cells = &ctx->letterMask[(unsigned char) c->letter * 
+										   ctx->boardWords];
+		for (int w = 0; w < ctx->boardWords && !ctx->stopped; w++) {
+			uint64_t bits = cells[w];
+			while (bits && !ctx->stopped) {
+				treeExploreA(ctx, c, base, 
+							 w * BITS_PER_WORD + takeLowestBit(&bits), p);
+			}
+		}
+	 }
+}
+
+/*
+	Explores both prefix tree and letters in board simultaneously using
+    depth-first search approach, starting from the given board cell. base is 
+	the word number base accumulated on the path to t.
+*/
+void treeExploreA(struct solverContext *ctx, struct trieNode *t, int base,
+	int cell, struct problem *p) {
+	int depth = 0;
+	if (ctx->boardWords == 1) {
+		exploreSmallA(ctx, t, base, cell, 0, depth);
+	} else {
+		searchPaths(ctx, &rulesA, ctx->frames, t, base, cell, 0);
+	}
+}
+
+/*
+	Depth-first search of part A on a board of at most 64 cells, with the 
+	cells on the path in the single word visited. The next cells for child 
+	c are the unvisited neighbours holding its letter. depth is the length of
+	the path before cell. It recurses rather than using searchPaths, as 
+	keeping the path's cells in a register word makes it about a fifth 
+	faster on such boards, and no path is longer than its 64 cells.
+*/
+static void exploreSmallA(struct solverContext *ctx, struct trieNode *t, 
+	int base, int cell, uint64_t visited, int depth) {
+	if (ctx->stopped) {
+		return;
+	}
+	ctx->path[depth] = cell;
+
+	/* mark matched word */
+	if (t->isEnd) {
+		recordWord(ctx, getWordNumber(t, base), depth);
+	}
+
+	/* terminate at leaf node */
+	if (t->numChild == 0) {
+		return;
+	}
+	visited |= (uint64_t) 1 << cell;
+	uint64_t around = ctx->neighbourMask[cell] & ~visited;
+	if (!around) {
+		return;
+	}
+
+	/* compares all children letters in tree against neighbours in board */
+	struct trieNode *c;
+	int childBase = getChildBase(t, base);
+    for (c = getFirstChild(ctx->index, t); c; 
+		 c = getNextSibling(ctx->index, c)) {
+		uint64_t next = around & ctx->letterMask[(unsigned char) c->letter];
+		while (next) {
+			exploreSmallA(ctx, c, childBase, takeLowestBit(&next), visited, 
+						  depth + 1);
+		}
+    }
+}
+
+/* Part B ********************************************************************/
+/*
+	Solves the given problem according to all part B's definitions
+	and places the solution output into a returned solution value.
+*/
+struct solution *solveProblemB(struct problem *p){
+	struct solverContext *ctx = newBoardSolverContext(p);
+	struct solution *s = solveBoardB(ctx, p);
+	/* follow letters are printed through the index's alphabet */
+	keepIndex(ctx, s);
+	freeSolverContext(ctx);
+	return s;
+}
+
+/*
+	Solves the board and partial string of the given problem according to 
+	part B's definitions with the context's dictionary.
+*/
+struct solution *solveBoardB(struct solverContext *ctx, struct problem *p){
+	struct prefixTree *t = ctx->index;
+	struct solution *s = newSolution(p, t);
+	struct trieNode *c;
+
+	/* prefixEnd[i] marks that the first i letters of the partial string 
+		form a word, followFound[c] that a word continues with letter c */
+	prepareSearch(ctx, p);
+
+	/* perform depth-first search by looping through all words in prefix tree */
+	for (c = getFirstChild(t, getRoot(t)); c; c = getNextSibling(t, c)) {
+
+		/* check if current letter in tree matches with partial string */
+		if (c->letter != ctx->partialCodes[0]) { 
+			continue; 
+		}
+	
+		/* Starts from every board cell holding the tree char */
+		uint64_t *cells = &ctx->letterMask[(unsigned char) c->letter * 
+										   ctx->boardWords];
+		for (int w = 0; w < ctx->boardWords; w++) {
+			uint64_t bits = cells[w];
+			while (bits) {
+				treeExploreB(ctx, c, w * BITS_PER_WORD + takeLowestBit(&bits));
+			}
+		}
+	 }
+
+	/* Get all the follow letters */
+	 collectFollowLetters(ctx->partialLength, ctx->prefixEnd, ctx->followFound,
+						  s);
+	 return s;
+}
+
+/*
+	Explores both prefix tree and letters in board simultaneously using
+    depth-first search approach over the precomputed neighbours of each cell,
+	starting from root child t at the given board cell.
+*/
+void treeExploreB(struct solverContext *ctx, struct trieNode *t, int cell) {
+	int base = 0;
+	searchPaths(ctx, &rulesB, ctx->frames, t, base, cell, 0);
+}
+
+/*
+	Part B rule marking the words the path spells: those ending within the 
+	partial string in prefixEnd, and those going past it under the letter 
+	following it, which is the letter at depth partialLength.
+*/
+static inline bool reachB(struct solverContext *ctx, 
+	struct searchFrame *frame) {
+	struct trieNode *t = frame->node;
+	if (t->isEnd) {
+		if (frame->depth >= ctx->partialLength) {
+			ctx->followFound[(unsigned char) 
+				ctx->frames[ctx->partialLength].node->letter] = true;
+		} else {
+			ctx->prefixEnd[frame->depth + 1] = true;
+		}
+	}
+	return t->numChild > 0;
+}
+
+/*
+	Part B rule trying only the partial string's next letter while the path
+	is within it, and every child past it.
+*/
+static inline struct trieNode *nextChildB(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child) {
+	if (frame->depth + 1 < ctx->partialLength) {
+		return child ? NULL : getChild(ctx->index, frame->node, 
+									   ctx->partialCodes[frame->depth + 1]);
+	}
+	return child ? getNextSibling(ctx->index, child) : 
+				   getFirstChild(ctx->index, frame->node);
+}
+
+/* Part B hint sessions ******************************************************/
+/*
+	Starts a hint session on the board of the given problem, with its 
+	partial string typed in already if it has one.
+*/
+struct hintSession *newHintSession(struct solverContext *ctx, 
+	struct problem *p){
+	struct hintSession *s = (struct hintSession *) 
+		malloc(sizeof(struct hintSession));
+	assert(s);
+	s->ctx = ctx;
+	s->problem = p;
+	s->length = 0;
+	s->levelAllocated = 0;
+	s->prefix = NULL;
+	s->nodes = NULL;
+	s->frontier = NULL;
+	s->followKnown = NULL;
+	s->followFound = NULL;
+	s->scratch = NULL;
+	s->scratchDepth = 0;
+	prepareSearch(ctx, p);
+	growHintLevels(s, INITIAL_HINT_LEVELS);
+
+	/* Level 0 is the empty prefix, which every path starts from */
+	s->nodes[0] = getRoot(ctx->index);
+	s->followKnown[0] = false;
+	for (int i = 0; i < ctx->partialLength; i++) {
+		appendHintCode(s, ctx->partialCodes[i]);
+	}
+	return s;
+}
+
+/*
+	Types one more letter, the UTF-8 character letter starts with. A letter 
+	missing from the alphabet is coded NO_SYMBOL, which no node has.
+*/
+void appendHintLetter(struct hintSession *s, const char *letter){
+	appendHintCode(s, (char) symbolCode(&s->ctx->index->alphabet, letter, 
+										symbolLength(letter)));
+}
+
+/*
+	Types one more letter, given its code: the paths of the new prefix are 
+	the neighbours of the old frontier holding the letter, or every cell 
+	holding it for the first letter.
+*/
+static void appendHintCode(struct hintSession *s, char letter){
+	struct solverContext *ctx = s->ctx;
+	int words = ctx->boardWords;
+	if (s->length + 2 > s->levelAllocated) {
+		growHintLevels(s, s->levelAllocated * DOUBLE);
+	}
+	int level = ++s->length;
+	s->prefix[level - 1] = letter;
+	s->prefix[level] = NULL_CHAR;
+	s->followKnown[level] = false;
+
+	struct trieNode *previous = s->nodes[level - 1];
+	s->nodes[level] = previous ? getChild(ctx->index, previous, letter) : NULL;
+	uint64_t *cells = &s->frontier[level * words];
+	if (!s->nodes[level]) {
+		memset(cells, 0, sizeof(uint64_t) * words);
+	} else if (level == 1) {
+		memcpy(cells, &ctx->letterMask[(unsigned char) letter * words], 
+			   sizeof(uint64_t) * words);
+	} else {
+		stepCells(ctx, &s->frontier[(level - 1) * words], letter, cells);
+	}
+}
+
+/*
+	Deletes the last letter typed, going back to the level before it, which 
+	is kept as it was.
+*/
+void deleteHintLetter(struct hintSession *s){
+	if (s->length > 0) {
+		s->prefix[--s->length] = NULL_CHAR;
+	}
+}
+
+/*
+	Returns the part B solution for the partial string typed so far: an end 
+	of word marker for each prefix of it which is a word and is spelled on 
+	the board, then the letters some word spelled on the board continues it
+	with. Only the follow letters of a level are searched for, once.
+*/
+struct solution *getSessionHints(struct hintSession *s){
+	struct solverContext *ctx = s->ctx;
+	int words = ctx->boardWords;
+	struct solution *sol = newSolution(s->problem, ctx->index);
+	/* the partial string typed may be longer than the problem's */
+	free(sol->followLetters);
+	sol->followLetters = (char *) malloc(sizeof(char) * 
+										 (MAX_CHAR + s->length));
+	assert(sol->followLetters);
+
+	for (int i = 1; i <= s->length; i++) {
+		if (s->nodes[i] && s->nodes[i]->isEnd && 
+			anyCell(&s->frontier[i * words], words)) {
+			sol->followLetters[sol->foundLetterCount++] = NULL_CHAR;
+		}
+	}
+
+	int level = s->length;
+	bool *follow = &s->followFound[level * MAX_CHAR];
+	if (!s->followKnown[level]) {
+		findFollowLetters(s, level, follow);
+		s->followKnown[level] = true;
+	}
+	for (int i = 0; i < MAX_CHAR; i++) {
+		if (follow[i]) {
+			sol->followLetters[sol->foundLetterCount++] = (char) i;
+		}
+	}
+	return sol;
+}
+
+/*
+	Frees the hint session, but not its context.
+*/
+void freeHintSession(struct hintSession *s){
+	if (s) {
+		free(s->prefix);
+		free(s->nodes);
+		free(s->frontier);
+		free(s->followKnown);
+		free(s->followFound);
+		free(s->scratch);
+		free(s);
+	}
+}
+
+/*
+	Answers many partial strings on one board by typing them into one hint
+	session in sorted order, so each only deletes back to the prefix it 
+	shares with the one before and types the rest. Every prefix shared by 
+	several partial strings is searched once.
+*/
+struct solution **solveBoardMultiB(struct solverContext *ctx, 
+	struct problem *p, char **partialStrings, int count){
+	struct solution **solutions = (struct solution **) 
+		malloc(sizeof(struct solution *) * (count + 1));
+	char ***sorted = (char ***) malloc(sizeof(char **) * (count + 1));
+	assert(solutions && sorted);
+	for (int i = 0; i < count; i++) {
+		sorted[i] = &partialStrings[i];
+	}
+	qsort(sorted, count, sizeof(char **), comparePartialStrings);
+
+	/* room for the codes of the longest partial string */
+	size_t longest = 0;
+	for (int i = 0; i < count; i++) {
+		if (strlen(partialStrings[i]) > longest) {
+			longest = strlen(partialStrings[i]);
+		}
+	}
+	char *codes = (char *) malloc(sizeof(char) * (longest + 1));
+	assert(codes);
+
+	struct hintSession *s = newHintSession(ctx, p);
+	for (int i = 0; i < count; i++) {
+		int length = 0;
+		int bytes;
+		for (char *c = *sorted[i]; *c; c += bytes) {
+			bytes = symbolLength(c);
+			codes[length++] = (char) symbolCode(&ctx->index->alphabet, c, 
+												bytes);
+		}
+		int common = 0;
+		while (common < s->length && common < length && 
+			   codes[common] == s->prefix[common]) {
+			common++;
+		}
+		while (s->length > common) {
+			deleteHintLetter(s);
+		}
+		for (int j = common; j < length; j++) {
+			appendHintCode(s, codes[j]);
+		}
+		solutions[sorted[i] - partialStrings] = getSessionHints(s);
+	}
+	freeHintSession(s);
+	free(codes);
+	free(sorted);
+	return solutions;
+}
+
+/*
+	Orders references to partial strings by the strings.
+*/
+static int comparePartialStrings(const void *s1, const void *s2) {
+	return strcmp(**(char ***) s1, **(char ***) s2);
+}
+
+/*
+	Makes room for levels prefix lengths, keeping the levels so far.
+*/
+static void growHintLevels(struct hintSession *s, int levels){
+	int words = s->ctx->boardWords;
+	s->levelAllocated = levels;
+	s->prefix = (char *) realloc(s->prefix, sizeof(char) * levels);
+	s->nodes = (struct trieNode **) realloc(s->nodes, 
+		sizeof(struct trieNode *) * levels);
+	s->frontier = (uint64_t *) realloc(s->frontier, 
+		sizeof(uint64_t) * words * levels);
+	s->followKnown = (bool *) realloc(s->followKnown, sizeof(bool) * levels);
+	s->followFound = (bool *) realloc(s->followFound, 
+		sizeof(bool) * MAX_CHAR * levels);
+	assert(s->prefix && s->nodes && s->frontier && s->followKnown && 
+		   s->followFound);
+	s->prefix[s->length] = NULL_CHAR;
+}
+
+/*
+	Marks the letters following the prefix of the given level in some word
+	spelled on the board, trying each child of its node in turn.
+*/
+static void findFollowLetters(struct hintSession *s, int level, bool *follow){
+	struct solverContext *ctx = s->ctx;
+	int words = ctx->boardWords;
+	memset(follow, false, sizeof(bool) * MAX_CHAR);
+	struct trieNode *t = s->nodes[level];
+	if (!t || (level > 0 && !anyCell(&s->frontier[level * words], words))) {
+		return;
+	}
+	growHintScratch(s, 1);
+	for (struct trieNode *c = getFirstChild(ctx->index, t); c; 
+		 c = getNextSibling(ctx->index, c)) {
+		bool reached;
+		if (level == 0) {
+			memcpy(s->scratch, 
+				   &ctx->letterMask[(unsigned char) c->letter * words], 
+				   sizeof(uint64_t) * words);
+			reached = anyCell(s->scratch, words);
+		} else {
+			reached = stepCells(ctx, &s->frontier[level * words], c->letter, 
+								s->scratch);
+		}
+		if (reached && completesWord(s, c, 0)) {
+			follow[(unsigned char) c->letter] = true;
+		}
+	}
+}
+
+/*
+	Whether some word below t, or t itself, is spelled by a path continuing
+	from the cells in scratch level depth. It recurses over the index alone,
+	one level per letter, stepping the set of cells a path may have reached,
+	as part B paths may repeat cells so following each path with searchPaths
+	would take exponential time.
+*/
+static bool completesWord(struct hintSession *s, struct trieNode *t, 
+	int depth){
+	if (t->isEnd) {
+		return true;
+	}
+	int words = s->ctx->boardWords;
+	growHintScratch(s, depth + 2);
+	for (struct trieNode *c = getFirstChild(s->ctx->index, t); c; 
+		 c = getNextSibling(s->ctx->index, c)) {
+		/* scratch may move as deeper levels grow it */
+		if (stepCells(s->ctx, &s->scratch[depth * words], c->letter, 
+					  &s->scratch[(depth + 1) * words]) && 
+			completesWord(s, c, depth + 1)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+	Makes room for depth board bitsets of scratch.
+*/
+static void growHintScratch(struct hintSession *s, int depth){
+	if (depth > s->scratchDepth) {
+		s->scratchDepth = depth * DOUBLE;
+		s->scratch = (uint64_t *) realloc(s->scratch, sizeof(uint64_t) * 
+			s->ctx->boardWords * s->scratchDepth);
+		assert(s->scratch);
+	}
+}
+
+/*
+	Sets to the cells holding the letter with the given code next to some 
+	cell of from, returning whether there are any.
+*/
+static bool stepCells(struct solverContext *ctx, uint64_t *from, char letter, 
+	uint64_t *to){
+	int words = ctx->boardWords;
+	bool any = false;
+	memset(to, 0, sizeof(uint64_t) * words);
+	for (int w = 0; w < words; w++) {
+		uint64_t bits = from[w];
+		while (bits) {
+			int cell = w * BITS_PER_WORD + takeLowestBit(&bits);
+			uint64_t next = matchingBytes(ctx->neighbourCodes[cell], letter);
+			any |= next != 0;
+			while (next) {
+				setBit(to, ctx->neighbours[cell * MAX_NEIGHBOURS + 
+										   takeLowestBit(&next) / CHAR_BIT]);
+			}
+		}
+	}
+	return any;
+}
+
+/*
+	Whether the board bitset holds any cell.
+*/
+static bool anyCell(uint64_t *cells, int words){
+	for (int w = 0; w < words; w++) {
+		if (cells[w]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Part D ********************************************************************/
+/*
+	Solves the given problem according to all part D's definitions
+	and places the solution output into a returned solution value.
+*/
+struct solution *solveProblemD(struct problem *p){
+	if (p->threads > 1 || p->dimension > HUGE_BOARD_DIMENSION) {
+		return solveProblemParallel(p, solveBoardParallelD);
+	}
+	struct solverContext *ctx = newBoardSolverContext(p);
+	struct solution *s = solveBoardD(ctx, p);
+	keepIndex(ctx, s);
+	freeSolverContext(ctx);
+	return s;
+}
+
+/*
+	Solves the board of the given problem according to part D's definitions 
+	with the context's dictionary.
+*/
+struct solution *solveBoardD(struct solverContext *ctx, struct problem *p){
+	if (searchInTiles(p, ctx->index)) {
+		return searchBoardTiled(&ctx, 1, p, searchTileD);
+	}
+	struct prefixTree *t = ctx->index;
+	struct solution *s = newSolution(p, t);
+
+	prepareSearch(ctx, p);
+	searchBoardD(ctx);
+
+	/* Get all the solutions in lexicographic order */
+	 collectSolutions(t, ctx->hits, ctx->hitCount, s);
+	 return s;
+}
+
+/*
+	Searches the board of the given problem according to part D's 
+	definitions, handing each word to consumer as soon as it is first found.
+*/
+bool streamBoardD(struct solverContext *ctx, struct problem *p, 
+	wordConsumer consumer, void *arg){
+	prepareSearch(ctx, p);
+	ctx->consumer = consumer;
+	ctx->consumerArg = arg;
+	searchBoardD(ctx);
+	return !ctx->stopped;
+}
+
+/*
+	Searches the board for part D from every cell holding a root letter, 
+	until the consumer stops the search.
+*/
+static void searchBoardD(struct solverContext *ctx){
+	struct prefixTree *t = ctx->index;
+	struct trieNode *c;
+	int base = 0;
+
+	/* perform depth-first search by looping through all words in prefix tree */
+	for (c = getFirstChild(t, getRoot(t)); c && !ctx->stopped; 
+		 c = getNextSibling(t, c)) {
+		uint64_t *cells = &ctx->letterMask[(unsigned char) c->letter * 
+										   ctx->boardWords];
+		for (int w = 0; w < ctx->boardWords && !ctx->stopped; w++) {
+			uint64_t bits = cells[w];
+			while (bits && !ctx->stopped) {
+				treeExploreD(ctx, c, base, 
+							 w * BITS_PER_WORD + takeLowestBit(&bits));
+			}
+		}
+	 }
+}
+
+/*
+	Whether the letter with the given code is on the path up to depth, given
+	its usedLetterBit is in the path's used letter mask. Only alphabets of 
+	more than 64 letters have codes sharing a bit, which the path's cells 
+	then tell apart.
+*/
+static inline bool usedOnPath(struct solverContext *ctx, char letter, 
+	int depth) {
+	if (ctx->index->alphabet.symbolCount <= BITS_PER_WORD) {
+		return true;
+	}
+	uint64_t *cells = &ctx->letterMask[(unsigned char) letter * 
+									   ctx->boardWords];
+	for (int i = 0; i <= depth; i++) {
+		if (testBit(cells, ctx->path[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+	Explores both prefix tree and letters in board simultaneously using
+    depth-first search approach, starting from root child t at the given 
+	board cell. base is the word number base accumulated on the path to t. 
+	A path never repeats a letter, so it never repeats a cell either.
+*/
+void treeExploreD(struct solverContext *ctx, struct trieNode *t, int base,
+	int cell) {
+	searchPaths(ctx, &rulesD, ctx->frames, t, base, cell, 0);
+}
+
+/*
+	Part D rule trying only the children with letters not used yet on the 
+	path.
+*/
+static inline struct trieNode *nextChildD(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child) {
+	struct trieNode *c = child ? getNextSibling(ctx->index, child) : 
+								 getFirstChild(ctx->index, frame->node);
+	while (c && (frame->used & usedLetterBit(c->letter)) && 
+		   usedOnPath(ctx, c->letter, frame->depth)) {
+		c = getNextSibling(ctx->index, c);
+	}
+	return c;
+}
+
+/*
+	Drops the dictionary words which repeat a letter, as no path can spell 
+	them under part D's definitions, so they never enter the index. Single 
+	byte letters are kept in a byte set, UTF-8 letters are compared with the
+	letters before them.
+*/
+void dropRepeatedLetterWords(struct problem *p){
+	int kept = 0;
+	for (int i = 0; i < p->wordCount; i++) {
+		uint64_t usedBytes[MAX_CHAR / BITS_PER_WORD] = {0};
+		bool repeated = false;
+		int length;
+		for (char *c = p->words[i]; *c && !repeated; c += length) {
+			length = symbolLength(c);
+			if (length == 1) {
+				repeated = testBit(usedBytes, (unsigned char) *c);
+				setBit(usedBytes, (unsigned char) *c);
+				continue;
+			}
+			int before;
+			for (char *b = p->words[i]; b < c && !repeated; b += before) {
+				before = symbolLength(b);
+				repeated = before == length && memcmp(b, c, length) == 0;
+			}
+		}
+		if (!repeated) {
+			p->words[kept++] = p->words[i];
+		}
+	}
+	p->wordCount = kept;
+}
+
+/* Scoring *******************************************************************/
+/*
+	Scores the board according to part A's definitions, streaming every 
+	distinct word into the board score.
+*/
+struct boardScore *scoreBoardA(struct solverContext *ctx, struct problem *p,
+	const struct scoreTable *table, int topLimit){
+	struct boardScore *s = newBoardScore(topLimit);
+	s->table = table;
+	streamBoardA(ctx, p, addScoredHit, s);
+	finishBoardScore(s);
+	return s;
+}
+
+/*
+	Scores the board according to part D's definitions.
+*/
+struct boardScore *scoreBoardD(struct solverContext *ctx, struct problem *p,
+	const struct scoreTable *table, int topLimit){
+	struct boardScore *s = newBoardScore(topLimit);
+	s->table = table;
+	streamBoardD(ctx, p, addScoredHit, s);
+	finishBoardScore(s);
+	return s;
+}
+
+/*
+	Consumer adding each word's score to the board score given as arg.
+*/
+static bool addScoredHit(void *arg, int wordNumber, const char *word, 
+	const int *path, int pathLength){
+	struct boardScore *s = (struct boardScore *) arg;
+	addWordScore(s, wordNumber, scoreWord(s->table, word, pathLength));
+	return true;
+}
+
+/*
+	Looks for the best scoring word on the board under part A's definitions.
+	A root letter or child is only searched when its bound beats the best 
+	word so far, or ties it with an earlier word.
+*/
+int bestScoreBoardA(struct solverContext *ctx, struct problem *p, 
+	struct scoreBounds *bounds, int *bestWord){
+	struct prefixTree *t = ctx->index;
+	struct bestSearch search = {bounds, bounds->table, -1, -1};
+	prepareSearch(ctx, p);
+	ctx->searchState = &search;
+
+	for (struct trieNode *c = getFirstChild(t, getRoot(t)); c; 
+		 c = getNextSibling(t, c)) {
+		int points = bounds->codePoints[(unsigned char) c->letter];
+		int bound = scoreBound(bounds, t, c, 1, points);
+		if (bound < search.best || 
+			(bound == search.best && c->wordsBefore > search.bestWord)) {
+			continue;
+		}
+		uint64_t *cells = &ctx->letterMask[(unsigned char) c->letter * 
+										   ctx->boardWords];
+		for (int w = 0; w < ctx->boardWords; w++) {
+			uint64_t bits = cells[w];
+			while (bits) {
+				searchPaths(ctx, &rulesBest, ctx->frames, c, 0, 
+							w * BITS_PER_WORD + takeLowestBit(&bits), 0);
+			}
+		}
+	}
+	ctx->searchState = NULL;
+	*bestWord = search.bestWord;
+	return search.best;
+}
+
+/*
+	Best word search rule keeping the word the path spells, if any, when it 
+	beats the best so far. The frame's points are the letter points of the 
+	path up to its node, the frame before it being the letter before.
+*/
+static inline bool reachBest(struct solverContext *ctx, 
+	struct searchFrame *frame) {
+	struct bestSearch *search = (struct bestSearch *) ctx->searchState;
+	struct trieNode *t = frame->node;
+	frame->points = search->bounds->codePoints[(unsigned char) t->letter] + 
+		(frame->depth > 0 ? (frame - 1)->points : 0);
+	if (t->isEnd) {
+		int w = getWordNumber(t, frame->base);
+		int length = frame->depth + 1;
+		int score = frame->points + search->table->lengthPoints[
+			length < SCORE_LENGTHS ? length : SCORE_LENGTHS - 1];
+		if (score > search->best || 
+			(score == search->best && w < search->bestWord)) {
+			search->best = score;
+			search->bestWord = w;
+		}
+	}
+	return t->numChild > 0;
+}
+
+/*
+	Best word search rule trying only the children whose bound beats the 
+	best word so far. The smallest word number below a child is its base 
+	number, so a child whose bound only ties the best can be skipped when 
+	that comes after the best word.
+*/
+static inline struct trieNode *nextChildBest(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child) {
+	struct bestSearch *search = (struct bestSearch *) ctx->searchState;
+	struct prefixTree *index = ctx->index;
+	child = child ? getNextSibling(index, child) : 
+					getFirstChild(index, frame->node);
+	for (; child; child = getNextSibling(index, child)) {
+		int points = frame->points + 
+			search->bounds->codePoints[(unsigned char) child->letter];
+		int bound = scoreBound(search->bounds, index, child, 
+							   frame->depth + 2, points);
+		if (bound > search->best || (bound == search->best && 
+			getWordNumber(child, frame->childBase) <= search->bestWord)) {
+			return child;
+		}
+	}
+	return NULL;
+}
+
+/*
+	Walks every path of the board spelling a word under part A's definitions.
+*/
+void walkPathsA(struct solverContext *ctx, struct problem *p, 
+	wordConsumer consumer, void *arg){
+	struct prefixTree *t = ctx->index;
+	struct pathWalk walk = {NULL, NULL, p->boardFlat, {NULL_CHAR, NULL_CHAR},
+		{consumer, consumer}, 0};
+	prepareSearch(ctx, p);
+	ctx->consumerArg = arg;
+	ctx->searchState = &walk;
+
+	for (struct trieNode *c = getFirstChild(t, getRoot(t)); c && !ctx->stopped;
+		 c = getNextSibling(t, c)) {
+		uint64_t *cells = &ctx->letterMask[(unsigned char) c->letter * 
+										   ctx->boardWords];
+		for (int w = 0; w < ctx->boardWords && !ctx->stopped; w++) {
+			uint64_t bits = cells[w];
+			while (bits && !ctx->stopped) {
+				searchPaths(ctx, &rulesWalk, ctx->frames, c, 0, 
+							w * BITS_PER_WORD + takeLowestBit(&bits), 0);
+			}
+		}
+	}
+	ctx->searchState = NULL;
+}
+
+/*
+	Walks the paths through the changed cell for each of its letters. The 
+	prefixes of the words are grown backwards from the cell along the 
+	reversed prefix DAWG, so only paths through the cell are ever searched.
+	The backward walk keeps its own frames, as each prefix it finds starts 
+	a forward walk in the context's frames.
+*/
+void walkLetterChangeA(struct solverContext *ctx, struct problem *p, 
+	struct prefixTree *reversePrefixes, int cell, char letter, 
+	wordConsumer removed, wordConsumer added, void *arg){
+	prepareSearch(ctx, p);
+	struct searchFrame *backFrames = (struct searchFrame *) malloc(
+		sizeof(struct searchFrame) * (ctx->index->maxWordLength + 1));
+	assert(backFrames);
+	struct pathWalk walk = {reversePrefixes, backFrames, p->boardFlat, 
+		{ctx->boardCodes[(unsigned char) p->boardFlat[cell]], 
+		 boardLetterCode(p, &ctx->index->alphabet, letter)}, 
+		{removed, added}, 0};
+	ctx->consumerArg = arg;
+	ctx->searchState = &walk;
+
+	for (walk.side = 0; walk.side < WALK_SIDES && !ctx->stopped; 
+		 walk.side++) {
+		struct trieNode *r = getChild(reversePrefixes, 
+									  getRoot(reversePrefixes), 
+									  walk.letters[walk.side]);
+		if (r) {
+			searchPaths(ctx, &rulesBack, backFrames, r, 0, cell, 0);
+		}
+	}
+	ctx->searchState = NULL;
+	free(backFrames);
+}
+
+/*
+	Path walk rule handing every path spelling a word to the walk's consumer
+	for its side.
+*/
+static inline bool reachPath(struct solverContext *ctx, 
+	struct searchFrame *frame) {
+	struct pathWalk *walk = (struct pathWalk *) ctx->searchState;
+	struct trieNode *t = frame->node;
+	ctx->path[frame->depth] = frame->cell;
+	if (t->isEnd) {
+		int w = getWordNumber(t, frame->base);
+		if (!walk->consumers[walk->side](ctx->consumerArg, w, 
+										 getWord(ctx->index, w), ctx->path, 
+										 frame->depth + 1)) {
+			ctx->stopped = true;
+		}
+	}
+	return t->numChild > 0;
+}
+
+/*
+	Backward walk rule, the frame's node being the prefix read backwards 
+	from the changed cell to the frame's cell. When the letters form a 
+	prefix of a word, the path carries on forwards from the changed cell 
+	with the words continuing that prefix, the cells of the backward path 
+	staying visited.
+*/
+static inline bool reachBack(struct solverContext *ctx, 
+	struct searchFrame *frame) {
+	struct pathWalk *walk = (struct pathWalk *) ctx->searchState;
+	struct prefixTree *index = ctx->index;
+	int length = frame->depth;
+	if (frame->node->isEnd) {
+		/* Look the prefix up forwards, putting its cells in order */
+		struct trieNode *t = getRoot(index);
+		int base = 0;
+		for (int i = length; i >= 0; i--) {
+			int at = walk->backFrames[i].cell;
+			ctx->path[length - i] = at;
+			base = getChildBase(t, base);
+			t = getChild(index, t, i > 0 ? 
+						 ctx->boardCodes[(unsigned char) walk->board[at]] : 
+						 walk->letters[walk->side]);
+			assert(t);
+		}
+		setBit(ctx->visited, frame->cell);
+		searchPaths(ctx, &rulesWalk, ctx->frames, t, base, 
+					walk->backFrames[0].cell, length);
+		/* the changed cell stays on the path of every prefix, the frame's 
+			cell is only visited once the walk goes past it */
+		setBit(ctx->visited, walk->backFrames[0].cell);
+		ctx->visited[frame->cell / BITS_PER_WORD] &= 
+			~((uint64_t) 1 << (frame->cell % BITS_PER_WORD));
+	}
+	return frame->node->numChild > 0;
+}
+
+/*
+	Backward walk rule trying every child of the reversed prefix DAWG in 
+	turn.
+*/
+static inline struct trieNode *nextChildBack(struct solverContext *ctx, 
+	struct searchFrame *frame, struct trieNode *child) {
+	struct pathWalk *walk = (struct pathWalk *) ctx->searchState;
+	return child ? getNextSibling(walk->reversePrefixes, child) : 
+				   getFirstChild(walk->reversePrefixes, frame->node);
+}
 
-/* New solutions **************************************************************/
-/* 
-	Sets up a solution for the given problem 
+/* Parallel solving ***********************************************************/
+/*
+	Solves the given problem with a board solver running on p->threads 
+	contexts which share one dictionary index.
 */
-struct solution *newSolution(struct problem *problem){
-	struct solution *s = (struct solution *) malloc(sizeof(struct solution));
-	assert(s);
-	s->foundWordCount = 0;
-	s->words = (char **) malloc(sizeof(char *) * (problem->wordCount * 2));
-	assert(s->words);
-	s->foundLetterCount = 0;
-	s->followLetters = (char *) malloc(sizeof(char) * MAX_CHAR);
-	assert(s->followLetters);
+static struct solution *solveProblemParallel(struct problem *p, 
+	struct solution *(*solveBoard)(struct solverContext **, int, 
+								   struct problem *)){
+	struct solverContext **contexts = (struct solverContext **) 
+		malloc(sizeof(struct solverContext *) * p->threads);
+	assert(contexts);
+	contexts[0] = newBoardSolverContext(p);
+	for (int i = 1; i < p->threads; i++) {
+		contexts[i] = newSolverContextFromIndex(contexts[0]->index);
+	}
+	struct solution *s = solveBoard(contexts, p->threads, p);
+	keepIndex(contexts[0], s);
+	/* the first context frees the index if it still owns it */
+	for (int i = p->threads - 1; i >= 0; i--) {
+		freeSolverContext(contexts[i]);
+	}
+	free(contexts);
 	return s;
 }
 
-/* Part A ********************************************************************/
 /*
-	Solves the given problem according to part A's definitions
-	and places the solution output into a returned solution value.
+	Solves the board of the given problem according to part A's definitions,
+	spreading (root letter, start cell) searches over one thread per context.
 */
-struct solution *solveProblemA(struct problem *p){
-	struct solution *s = newSolution(p);
-	int i;
+struct solution *solveBoardParallelA(struct solverContext **contexts, 
+	int threadCount, struct problem *p){
+	if (searchInTiles(p, contexts[0]->index)) {
+		return searchBoardTiled(contexts, threadCount, p, searchTileA);
+	}
+	return searchBoardParallel(contexts, threadCount, p, searchTaskA);
+}
 
-	/* create and add words from dictionary into prefix tree */
-	struct prefixTree *t = newPrefixTree();
-	addDictionaryToTree(t, p);
+/*
+	Solves the board of the given problem according to part D's definitions,
+	spreading (root letter, start cell) searches over one thread per context.
+*/
+struct solution *solveBoardParallelD(struct solverContext **contexts, 
+	int threadCount, struct problem *p){
+	if (searchInTiles(p, contexts[0]->index)) {
+		return searchBoardTiled(contexts, threadCount, p, searchTileD);
+	}
+	return searchBoardParallel(contexts, threadCount, p, searchTaskD);
+}
 
-	bool *visited = (bool *)malloc(sizeof(bool) * p->dimension * p->dimension);
-	assert(visited);
+/*
+	Runs one search task per board cell matching a root letter over one 
+	thread per context, then collects the words every context found.
+*/
+static struct solution *searchBoardParallel(struct solverContext **contexts,
+	int threadCount, struct problem *p, 
+	void (*searchTask)(void *, int, int)){
+	struct prefixTree *t = contexts[0]->index;
+	struct solution *s = newSolution(p, t);
+	struct trieNode *c;
+	int cells = p->dimension * p->dimension;
+
+	for (int i = 0; i < threadCount; i++) {
+		prepareSearch(contexts[i], p);
+	}
 
-	/* perform depth-first search by looping through all words in prefix tree */
-	for (i = 0; i < MAX_CHAR; i++) {
-		memset(visited, false, sizeof(bool) * p->dimension * p->dimension);
-		if (t->child[i]) {
-
-			/* Loops through all words in board and compare first tree char */
-			for (int j = 0; j < p->dimension * p->dimension; j++) {
-				char *currChar = getStr(&(p->boardFlat[j]));
-				if (strcmp(currChar, t->child[i]->word) == 0) {
-				  	treeExploreA(t->child[i], s, &p->boardFlat[j], p, visited);
-				}
-				free(currChar);
+	/* one task per board cell matching a root letter */
+	struct parallelSearch search;
+	search.contexts = contexts;
+	search.p = p;
+	search.taskCount = 0;
+	search.tasks = (struct searchTask *) malloc(sizeof(struct searchTask) * 
+												(cells + 1));
+	assert(search.tasks);
+	for (c = getFirstChild(t, getRoot(t)); c; c = getNextSibling(t, c)) {
+		uint64_t *letter = &contexts[0]->letterMask[(unsigned char) c->letter * 
+													contexts[0]->boardWords];
+		for (int w = 0; w < contexts[0]->boardWords; w++) {
+			uint64_t bits = letter[w];
+			while (bits) {
+				search.tasks[search.taskCount].root = c;
+				search.tasks[search.taskCount++].cell = 
+					w * BITS_PER_WORD + takeLowestBit(&bits);
 			}
 		}
-	 }
-
-	/* Get all the solutions using another DFS on marked words */
-	 for (i = 0; i < MAX_CHAR; i++) { 
-		if (t->child[i]) { 
-			exploreSolutions(t->child[i], s, p);
-		}
-	 }
+	}
+	runTasks(search.taskCount, threadCount, searchTask, &search);
+	free(search.tasks);
 
-	 freeTree(t);
-	 free(visited);
-	 return s;
+	/* Get all the solutions in lexicographic order */
+	mergeFound(contexts, threadCount);
+	collectSolutions(t, contexts[0]->hits, contexts[0]->hitCount, s);
+	return s;
 }
 
 /*
-	Explores both prefix tree and letters in board simultaneously using
-    depth-first search approach and queue data structure.
+	Runs one part A task with the worker's own visited cells and found words.
 */
-void treeExploreA(struct prefixTree *t, struct solution *s, char *charInBoard, 
-	struct problem *p, bool *visited) {
+static void searchTaskA(void *arg, int taskIndex, int worker){
+	struct parallelSearch *search = (struct parallelSearch *) arg;
+	struct searchTask *task = &search->tasks[taskIndex];
+	struct solverContext *ctx = search->contexts[worker];
+	int base = 0;
+	/* visited is back to all false after every search */
+	treeExploreA(ctx, task->root, base, task->cell, search->p);
+}
 
-	/* mark matched word */
-	if (t->isEnd && !visited[charInBoard - p->boardFlat]) {
-		t->markedWord = true;
-	}
-	visited[charInBoard - p->boardFlat] = true;
+/*
+	Runs one part D task with the worker's own found words.
+*/
+static void searchTaskD(void *arg, int taskIndex, int worker){
+	struct parallelSearch *search = (struct parallelSearch *) arg;
+	struct searchTask *task = &search->tasks[taskIndex];
+	int base = 0;
+	treeExploreD(search->contexts[worker], task->root, base, task->cell);
+}
 
-	/* terminate at leaf node */
-	if (t->numChild == 0) {
-		if (t->markedWord) {
-			visited[charInBoard - p->boardFlat] = false;
+/*
+	Merges the words found by every context into the first one.
+*/
+static void mergeFound(struct solverContext **contexts, int count){
+	struct solverContext *first = contexts[0];
+	for (int i = 1; i < count; i++) {
+		for (int h = 0; h < contexts[i]->hitCount; h++) {
+			int w = contexts[i]->hits[h];
+			if (first->foundStamp[w] != first->generation) {
+				first->foundStamp[w] = first->generation;
+				pushHit(first, w);
+			}
 		}
-		return;
 	}
+}
 
-	/* compares all children letters in tree against neighbours in board */
-    for (int i = 0; i < MAX_CHAR; i++) {
-         if (t->child[i]) {
-			/* stores all the MATCHED neighbours of current letter*/
-			struct queue *q = createQueue();
-		 	getNeighbour(charInBoard, i, p, q);
-			while (q->head) {
-				char *neighbourChar = dequeue(q);
-				if (!visited[neighbourChar - p->boardFlat]) {
-					treeExploreA(t->child[i], s, neighbourChar, p, visited);	
-				} 
-			}
-			freeQueue(q);
-		} 
-    }
-	visited[charInBoard - p->boardFlat] = false;
+/* Huge boards ***************************************************************/
+/*
+	Whether the board is huge and its tiles' windows, sized for the index's
+	longest word, are smaller than the board. Otherwise the board is 
+	searched whole, as a window would take at least as much memory.
+*/
+static bool searchInTiles(struct problem *p, struct prefixTree *t){
+	struct tiledSearch search;
+	return p->dimension > HUGE_BOARD_DIMENSION && sizeTiles(&search, p, t);
 }
 
-/* Part B ********************************************************************/
 /*
-	Solves the given problem according to all part B's definitions
-	and places the solution output into a returned solution value.
+	Sizes the tiles of a search of the problem's board for the index's 
+	longest word, returning whether a window is smaller than the board.
 */
-struct solution *solveProblemB(struct problem *p){
-	struct solution *s = newSolution(p);
-	int i;
-	int partialIndex = 0;
-	struct prefixTree *partialStringEnd = NULL;
+static bool sizeTiles(struct tiledSearch *search, struct problem *p, 
+	struct prefixTree *t){
+	/* a path reaches at most one cell further per letter after its first,
+		and never further than the board's far side */
+	int reach = t->maxWordLength > 1 ? t->maxWordLength - 1 : 0;
+	search->halo = reach < p->dimension - 1 ? reach : p->dimension - 1;
+	/* a tile at least as wide as its halo keeps the windows' cells within 
+		a small multiple of the board's */
+	search->tileSize = TILE_WINDOW - 2 * search->halo;
+	if (search->tileSize < MIN_TILE) {
+		search->tileSize = MIN_TILE;
+	}
+	if (search->tileSize < search->halo) {
+		search->tileSize = search->halo;
+	}
+	search->windowSize = search->tileSize + 2 * search->halo;
+	search->tilesPerSide = (p->dimension + search->tileSize - 1) / 
+		search->tileSize;
+	return search->windowSize < p->dimension;
+}
 
-	/* create and add words from dictionary into prefix tree */
-	struct prefixTree *t = newPrefixTree();
-	addDictionaryToTree(t, p);
+/*
+	Searches a huge board one tile at a time over one thread per context. A 
+	tile's search only needs a window of the board just wider than the 
+	longest word, so the contexts' bitsets are sized for the window rather 
+	than the board, and each worker keeps the words it finds across its 
+	tiles until they are merged at the end.
+*/
+static struct solution *searchBoardTiled(struct solverContext **contexts, 
+	int threadCount, struct problem *p, void (*searchTile)(void *, int, int)){
+	struct prefixTree *t = contexts[0]->index;
+	struct solution *s = newSolution(p, t);
+	struct tiledSearch search;
+	search.contexts = contexts;
+	search.p = p;
+	sizeTiles(&search, p, t);
+	int windowCells = search.windowSize * search.windowSize;
+	int windowWords = bitsetWords(windowCells);
+
+	search.windows = (struct problem *) malloc(sizeof(struct problem) * 
+											   threadCount);
+	search.windowLetters = (char *) malloc(sizeof(char) * windowCells * 
+										   threadCount);
+	search.cores = (uint64_t *) malloc(sizeof(uint64_t) * windowWords * 
+									   threadCount);
+	assert(search.windows && search.windowLetters && search.cores);
+	for (int i = 0; i < threadCount; i++) {
+		/* a window keeps the board's UTF-8 letters and search settings */
+		search.windows[i] = *p;
+		search.windows[i].dimension = search.windowSize;
+		search.windows[i].boardFlat = &search.windowLetters[i * windowCells];
+		search.windows[i].board = NULL;
+		startSearch(contexts[i]);
+	}
+	runTasks(search.tilesPerSide * search.tilesPerSide, threadCount, 
+			 searchTile, &search);
+	free(search.windows);
+	free(search.windowLetters);
+	free(search.cores);
+
+	/* Get all the solutions in lexicographic order */
+	mergeFound(contexts, threadCount);
+	collectSolutions(t, contexts[0]->hits, contexts[0]->hitCount, s);
+	return s;
+}
 
-	/* perform depth-first search by looping through all words in prefix tree */
-	for (i = 0; i < MAX_CHAR; i++) {
-		if (t->child[i]) {
-
-			/* check if current letter in tree matches with partial string */
-			char *partialStr = getStr(&(p->partialString[0]));
-			if (strcmp(t->child[i]->word, partialStr) != 0) { 
-				free(partialStr);
-				continue; 
-			}
-			free(partialStr);
-			partialIndex++;
-		
-			/* Loops through all words in board and compare with tree char */
-			for (int j = 0; j < p->dimension * p->dimension; j++) {
-				char *currChar = getStr(&(p->boardFlat[j]));
-				if (strcmp(currChar, t->child[i]->word) == 0) {
-				  	treeExploreB(t->child[i], s, &p->boardFlat[j], partialIndex, 
-                                 p, &partialStringEnd);
-				}
-				free(currChar);
+/*
+	Runs the part A search from every cell of one tile.
+*/
+static void searchTileA(void *arg, int tileIndex, int worker){
+	struct tiledSearch *search = (struct tiledSearch *) arg;
+	struct solverContext *ctx = search->contexts[worker];
+	struct prefixTree *t = ctx->index;
+	struct trieNode *c;
+	int base = 0;
+	uint64_t *core = loadTile(search, tileIndex, worker);
+	for (c = getFirstChild(t, getRoot(t)); c; c = getNextSibling(t, c)) {
+		uint64_t *cells = &ctx->letterMask[(unsigned char) c->letter * 
+										   ctx->boardWords];
+		for (int w = 0; w < ctx->boardWords; w++) {
+			uint64_t bits = cells[w] & core[w];
+			while (bits) {
+				treeExploreA(ctx, c, base, 
+							 w * BITS_PER_WORD + takeLowestBit(&bits), 
+							 &search->windows[worker]);
 			}
 		}
-	 }
-
-	/* Get all the solutions using another DFS on marked words */
-	 for (i = 0; i < MAX_CHAR; i++) { 
-		if (t->child[i]) { 
-			exploreSolutions(t->child[i], s, p);
-		}
-	 }
-
-	 freeTree(t);
-	 return s;
+	}
 }
 
 /*
-	Explores both prefix tree and letters in board simultaneously using
-    depth-first search approach and queue data structure.
+	Runs the part D search from every cell of one tile.
 */
-void treeExploreB(struct prefixTree *t, struct solution *s, char *charInBoard, 
-	int partialIndex, struct problem *p, struct prefixTree **partialStringEnd) {
-
-	/* pointing to subsequent letter of partial string */
-	if (partialIndex == p->partialSize + 1) {
-		*partialStringEnd = t;
-	} 
-	
-	/* mark matched word */
-	if (t->isEnd) {
-		if (*partialStringEnd) {
-			(*partialStringEnd)->markedWord = true;
-		} else {
-			t->isEndB = true;
+static void searchTileD(void *arg, int tileIndex, int worker){
+	struct tiledSearch *search = (struct tiledSearch *) arg;
+	struct solverContext *ctx = search->contexts[worker];
+	struct prefixTree *t = ctx->index;
+	struct trieNode *c;
+	int base = 0;
+	uint64_t *core = loadTile(search, tileIndex, worker);
+	for (c = getFirstChild(t, getRoot(t)); c; c = getNextSibling(t, c)) {
+		uint64_t *cells = &ctx->letterMask[(unsigned char) c->letter * 
+										   ctx->boardWords];
+		for (int w = 0; w < ctx->boardWords; w++) {
+			uint64_t bits = cells[w] & core[w];
+			while (bits) {
+				treeExploreD(ctx, c, base, 
+							 w * BITS_PER_WORD + takeLowestBit(&bits));
+			}
 		}
 	}
+}
 
-	/* terminate at leaf node */
-	if (t->numChild == 0) {
-		return;
+/*
+	Copies the window of one tile into the worker's window board, with the
+	cells off the board holding no letter, and readies the worker's context
+	for it. Returns the window cells inside the tile.
+*/
+static uint64_t *loadTile(struct tiledSearch *search, int tileIndex, 
+	int worker){
+	struct problem *p = search->p;
+	struct solverContext *ctx = search->contexts[worker];
+	char *letters = search->windows[worker].boardFlat;
+	int size = search->windowSize;
+	int halo = search->halo;
+	int top = tileIndex / search->tilesPerSide * search->tileSize - halo;
+	int left = tileIndex % search->tilesPerSide * search->tileSize - halo;
+	/* columns of the window on the board */
+	int from = left < 0 ? -left : 0;
+	int to = left + size > p->dimension ? p->dimension - left : size;
+
+	memset(letters, OFF_BOARD, sizeof(char) * size * size);
+	for (int r = 0; r < size; r++) {
+		int row = top + r;
+		if (row >= 0 && row < p->dimension) {
+			memcpy(&letters[r * size + from], 
+				   &p->boardFlat[row * p->dimension + left + from], 
+				   sizeof(char) * (to - from));
+		}
 	}
-
-	/* compares all children letters in tree against neighbours in board */
-    for (int i = 0; i < MAX_CHAR; i++) {
-        if (t->child[i]) {
-			if ((partialIndex < p->partialSize && (char) i == 
-               p->partialString[partialIndex]) || partialIndex>=p->partialSize){
-                /* stores all the MATCHED neighbours of current letter */
-				struct queue *q = createQueue();
-				getNeighbour(charInBoard, i, p, q);
-				while (q->head) {
-					char *neighbourChar = dequeue(q);				
-					treeExploreB(t->child[i], s, neighbourChar, 
-									partialIndex + 1, p, partialStringEnd);	
-				}
-				freeQueue(q);
-			} 
+	prepareBoard(ctx, &search->windows[worker]);
+
+	uint64_t *core = &search->cores[worker * ctx->boardWords];
+	memset(core, 0, sizeof(uint64_t) * ctx->boardWords);
+	for (int r = halo; r < halo + search->tileSize && top + r < p->dimension;
+		 r++) {
+		for (int c = halo; 
+			 c < halo + search->tileSize && left + c < p->dimension; c++) {
+			setBit(core, r * size + c);
 		}
-    }
-	/* reset the pointer for every new word */
-	if (t == *partialStringEnd) {
-		*partialStringEnd = NULL;
 	}
+	return core;
 }
 
-/* Part D ********************************************************************/
 /*
-	Solves the given problem according to all part D's definitions
-	and places the solution output into a returned solution value.
+	Sets how many threads solveProblemA and solveProblemD search with.
 */
-struct solution *solveProblemD(struct problem *p){
-	struct solution *s = newSolution(p);
-	int i;
+void setSolverThreads(struct problem *p, int threads){
+	p->threads = threads;
+}
 
-	/* create and add words from dictionary into prefix tree */
-	struct prefixTree *t = newPrefixTree();
-	addDictionaryToTree(t, p);
+/*
+	Changes the letter of one board cell to a single byte letter.
+*/
+void setBoardLetter(struct problem *p, int cell, char letter){
+	assert(cell >= 0 && cell < p->dimension * p->dimension);
+	p->boardFlat[cell] = letter;
+}
 
-	/* perform depth-first search by looping through all words in prefix tree */
-	for (i = 0; i < MAX_CHAR; i++) {
-		bool visited[MAX_CHAR] = {false};
-
-		if (t->child[i]) {
-			/* Loops through all words in board and compare with tree char */
-			for (int j = 0; j < p->dimension * p->dimension; j++) {
-				char *currChar = getStr(&(p->boardFlat[j]));
-				if (strcmp(currChar, t->child[i]->word) == 0) {
-					visited[i] = true;
-				  	treeExploreD(t->child[i], s, &p->boardFlat[j], 
-                                p, visited);
+/* Helper functions ***********************************************************/
+/* 
+	Stores the neighbours of every cell of a board with the given dimension,
+	and sizes the board bitsets for it, unless the context already holds 
+	them. A cell has up to 8 neighbours, listed in the order of their cells 
+	so searches meet them in the order of a board bitset. Boards of a single
+	bitset word also get a neighbour bitset per cell.
+*/
+static void buildAdjacency(struct solverContext *ctx, int dimension) {
+	if (dimension == ctx->adjacencyDimension) {
+		return;
+	}
+	int cells = dimension * dimension;
+	int words = bitsetWords(cells);
+	free(ctx->neighbours);
+	free(ctx->neighbourMask);
+	free(ctx->neighbourCodes);
+	free(ctx->visited);
+	free(ctx->letterMask);
+	free(ctx->path);
+	ctx->neighbours = (int *) malloc(sizeof(int) * cells * MAX_NEIGHBOURS);
+	ctx->neighbourMask = NULL;
+	if (words == 1) {
+		ctx->neighbourMask = (uint64_t *) calloc(cells, sizeof(uint64_t));
+		assert(ctx->neighbourMask);
+	}
+	ctx->neighbourCodes = (uint64_t *) malloc(sizeof(uint64_t) * cells);
+	ctx->visited = (uint64_t *) malloc(sizeof(uint64_t) * words);
+	ctx->letterMask = (uint64_t *) calloc(MAX_CHAR * words, sizeof(uint64_t));
+	ctx->heldLetterCount = 0;
+	/* no path repeats a cell */
+	ctx->path = (int *) malloc(sizeof(int) * cells);
+	assert(ctx->neighbours && ctx->neighbourCodes && ctx->visited && 
+		   ctx->letterMask && ctx->path);
+	ctx->boardWords = words;
+	/* row and column steps, in the order of the neighbours' cells */
+	static const int rowStep[MAX_NEIGHBOURS] = {-1, -1, -1, 0, 0, 1, 1, 1};
+	static const int colStep[MAX_NEIGHBOURS] = {-1, 0, 1, -1, 1, -1, 0, 1};
+
+	for (int cell = 0; cell < cells; cell++) {
+		int row = cell / dimension;
+		int col = cell % dimension;
+		int *around = &ctx->neighbours[cell * MAX_NEIGHBOURS];
+		int count = 0;
+		for (int k = 0; k < MAX_NEIGHBOURS; k++) {
+			int r = row + rowStep[k];
+			int c = col + colStep[k];
+			if (r >= 0 && r < dimension && c >= 0 && c < dimension) {
+				around[count++] = r * dimension + c;
+				if (words == 1) {
+					setBit(&ctx->neighbourMask[cell], r * dimension + c);
 				}
-				free(currChar);
 			}
 		}
-	 }
-
-	/* Get all the solutions using another DFS on marked words */
-	 for (i = 0; i < MAX_CHAR; i++) { 
-		if (t->child[i]) { 
-			exploreSolutions(t->child[i], s, p);
+		for (; count < MAX_NEIGHBOURS; count++) {
+			around[count] = NO_CELL;
 		}
-	 }
-
-	 freeTree(t);
-	 return s;
+	}
+	ctx->adjacencyDimension = dimension;
 }
 
 /*
-	Explores both prefix tree and letters in board simultaneously using
-    depth-first search approach and queue data structure.
+	Hands word number w, found along the first depth + 1 cells of the path, 
+	to the context's consumer unless the current search found it already. 
+	Stops the search if the consumer asks to.
 */
-void treeExploreD(struct prefixTree *t, struct solution *s, char *charInBoard,
-	struct problem *p, bool *visited) {
-
-	/* mark matched word */
-	if (t->isEnd) {
-		t->markedWord = true;
-		int len = strlen(t->word);
-		/* mark word as visited */
-		for (int p = 0; p < len; p++) {
-			visited[(int) t->word[p]] = true;
-		}
+static inline void recordWord(struct solverContext *ctx, int w, int depth) {
+	if (ctx->foundStamp[w] == ctx->generation) {
+		return;
 	}
+	ctx->foundStamp[w] = ctx->generation;
+	if (!ctx->consumer(ctx->consumerArg, w, getWord(ctx->index, w), ctx->path,
+					   depth + 1)) {
+		ctx->stopped = true;
+	}
+}
 
-	/* terminate at leaf node */
-	if (t->numChild == 0) {
-		return;
+/*
+	Appends word number w to the context's hits.
+*/
+static void pushHit(struct solverContext *ctx, int w) {
+	if (ctx->hitCount >= ctx->hitAllocated) {
+		ctx->hitAllocated *= DOUBLE;
+		ctx->hits = (int *) realloc(ctx->hits, sizeof(int) * ctx->hitAllocated);
+		assert(ctx->hits);
 	}
+	ctx->hits[ctx->hitCount++] = w;
+}
 
-	/* compares all children letters of current letter in tree against 
-        neighbours in board */
-    for (int i = 0; i < MAX_CHAR; i++) {
-         if (t->child[i] && !visited[i]) {
-            /* search through all neighbours of current board character */
-			struct queue *q = createQueue();
-		 	getNeighbour(charInBoard, i, p, q);
-			char *neighbourChar = NULL;
-			while (q->head) {
-				neighbourChar = dequeue(q);
-				if (!visited[(int) neighbourChar[0]]) {
-					 treeExploreD(t->child[i], s, neighbourChar, p, visited);
-				} 
-			}
-            /* Unvisited char for every new word */
-			if (neighbourChar) {
-				visited[(int) neighbourChar[0]] = false; 
-			}
-			freeQueue(q);
-		} 
-    }
+/*
+	Consumer building a solution: keeps every word number in the hits of the
+	context given as arg, to be sorted once the search is done.
+*/
+static bool appendHit(void *arg, int wordNumber, const char *word, 
+	const int *path, int pathLength) {
+	pushHit((struct solverContext *) arg, wordNumber);
+	return true;
 }
 
-/* Helper functions ***********************************************************/
-/* 
-	Store all neighbours of current board piece (that matches with current 
-    letter in tree) in queue. Time complexity of O(1).
-*/
-void getNeighbour(char *charInBoard, int treeIndex, struct problem *p, struct
-                  queue *q) {
-
-	/* Converting flat board into 3D grid by getting row and column indexes */
-	int step = p->dimension;
-	int row = (charInBoard - p->boardFlat) / p->dimension;
-	int col = (charInBoard - p->boardFlat) - row * step;
-    char treeChar = (char) treeIndex;
-
-	/* check above neighbour */
-	if (row != 0 && (treeChar == p->boardFlat[(row - 1) * step + col])) {
-		enqueue(q, &(p->boardFlat[(row - 1) * step + col]));
-	} 
-	/* check below neighbour */
-	if (row != (p->dimension - 1) && 
-		(treeChar == p->boardFlat[(row + 1) * step + col])) {
-		enqueue(q, &(p->boardFlat[(row + 1) * step + col]));
-	} 
-	/* check left neighbour */
-	if (col != 0 && (treeChar == p->boardFlat[row * step + (col - 1)])) {
-		enqueue(q, &(p->boardFlat[row * step + (col - 1)]));
-	} 
-	/* check right neighbour */
-	if (col != (p->dimension - 1) && 
-		(treeChar == p->boardFlat[row * step + (col + 1)])) {
-		enqueue(q, &(p->boardFlat[row * step + (col + 1)]));
-	}  
-	/* check upper right neighbour */
-	if (row != 0 && col != (p->dimension - 1) && 
-        (treeChar == p->boardFlat[(row - 1) * step + (col + 1)])) {
-		enqueue(q, &(p->boardFlat[(row - 1) * step + (col + 1)]));
-	}  
-	/* check upper left neighbour */
-	if (row != 0 && col != 0 && 
-        (treeChar == p->boardFlat[(row - 1) * step + (col - 1)])) {
-		enqueue(q, &(p->boardFlat[(row - 1) * step + (col - 1)]));
-	}  
-	/* check lower left neighbour */
-	if (row != (p->dimension - 1) && col != 0 && 
-        (treeChar == p->boardFlat[(row + 1) * step + (col - 1)])) {
-		enqueue(q, &(p->boardFlat[(row + 1) * step + (col - 1)]));
-	} 
-	/* check lower right neighbour */
-	if (row != (p->dimension - 1) && col != (p->dimension - 1) && 
-        (treeChar== p->boardFlat[(row + 1) * step + (col + 1)])) {
-		enqueue(q, &(p->boardFlat[(row + 1) * step + (col + 1)]));
-	}
-}
-
-/*
-    Inserts the found word into solution data structure (for all parts A-D) via 
-    DFS on prefix tree.
-*/
-void exploreSolutions(struct prefixTree *t,struct solution *s,struct problem*p){
-	
-	/* Insert solution into solution struct */
-	/* For parts A and D */
-	if ((p->part == PART_A || p->part == PART_D) && t->markedWord) {
-		char *foundWord = (char *) malloc(strlen(t->word) + 1);
-		assert(foundWord);
-		strcpy(foundWord, t->word);
-		s->words[(s->foundWordCount)++] = foundWord;
-
-	/* For part B */
-	} else if (p->part == PART_B) {
-		if (t->isEndB) {
+/*
+	Orders word numbers ascending.
+*/
+static int compareWordNumbers(const void *w1, const void *w2) {
+	int a = *(const int *) w1;
+	int b = *(const int *) w2;
+	return (a > b) - (a < b);
+}
+
+/*
+    Inserts the found words into solution data structure (parts A and D) in 
+	lexicographic order, which is word number order. Only the hits are 
+	sorted and kept, as word numbers, so the cost does not depend on the 
+	dictionary size.
+*/
+void collectSolutions(struct prefixTree *t, int *hits, int hitCount, 
+	struct solution *s){
+	qsort(hits, hitCount, sizeof(int), compareWordNumbers);
+	s->index = t;
+	s->wordNumbers = (int *) malloc(sizeof(int) * (hitCount + 1));
+	assert(s->wordNumbers);
+	memcpy(s->wordNumbers, hits, sizeof(int) * hitCount);
+	s->foundWordCount = hitCount;
+}
+
+/*
+    Inserts the found follow letters into solution data structure (part B).
+	Each prefix of the partial string which is a word adds an end of word 
+	marker first, followed by the codes of the letters in ascending order.
+*/
+void collectFollowLetters(int partialLength, bool *prefixEnd, 
+	bool *followFound, struct solution *s) {
+	for (int i = 1; i <= partialLength; i++) {
+		if (prefixEnd[i]) {
 			s->followLetters[(s->foundLetterCount)++] = NULL_CHAR; 
-		} else if (t->markedWord) {
-			if (isalpha(t->word[strlen(t->word)-1])) {
-		 		s->followLetters[(s->foundLetterCount)++]=
-                    t->word[strlen(t->word)-1]; 
-			} else {
-				s->followLetters[(s->foundLetterCount)++] = NULL_CHAR; 
-			}
 		}
 	}
-
-	/* Traverse through the child tree */
-	for (int i = 0; i < MAX_CHAR; i++) { 
-		if (t->child[i]) {
-			exploreSolutions(t->child[i], s, p);
+	for (int i = 0; i < MAX_CHAR; i++) {
+		if (followFound[i]) {
+	 		s->followLetters[(s->foundLetterCount)++] = (char) i; 
 		}
 	}
 }
@@ -413,72 +2083,43 @@ void exploreSolutions(struct prefixTree *t,struct solution *s,struct problem*p){
 void addDictionaryToTree(struct prefixTree *t, struct problem *p) {
 	int i;
 	/* Add all words into tree */
-	strcpy((t->word = malloc(NUM_2)), DEFAULT_STR);
 	for (i = 0; i < p->wordCount; i++) {
-		t = addWordToTree(t, p->words[i]);
-	}
-	/* convert all pieces in board to lower case */
-	for (i = 0; i < p->dimension * p->dimension; i++) {
-		p->boardFlat[i] = tolower(p->boardFlat[i]);
+		t = addWordToTree(t, p->words[i], i);
 	}
+	numberTreeWords(t, p->words);
 }
 
-/* Queue structure ************************************************************/
 /*
-    Create new queue.
-*/
-struct queue *createQueue() {
-    struct queue *queue = malloc(sizeof(struct queue));
-	assert(queue);
-    queue->head = queue->tail = NULL;
-    return queue;
-}
-
-/* 
-    Removes and return the item in the front-most node.
+    Builds the dictionary index selected for the problem from its words, 
+    spelled in the codes of an alphabet of their letters.
 */
-char *dequeue(struct queue *queue) {
-    if (!queue->head) { 
-        return NULL; 
-    }
-    char *word = queue->head->item;
-    struct node *curr = queue->head;
-    queue->head = queue->head->next;
-	free(curr);
-    return word;
+struct prefixTree *buildDictionaryIndex(struct problem *p) {
+	struct prefixTree *t;
+	struct alphabet alphabet;
+	buildAlphabet(&alphabet, p->words, p->wordCount);
+	if (p->index == INDEX_DAWG) {
+		t = newDawg(p->words, p->wordCount, &alphabet);
+	} else {
+		t = newPrefixTree(&alphabet);
+		addDictionaryToTree(t, p);
+	}
+	return t;
 }
 
 /*
-    Inserts new node into queue.
+	Selects the dictionary index the solvers build for the problem.
 */
-void enqueue(struct queue *queue, char *word) {
-    struct node *newNode = malloc(sizeof(struct node));
-    assert(newNode);
-    newNode->next = NULL;
-    newNode->item = word;
-
-	if (!queue->head) {
-		queue->head = queue->tail = newNode;
-		return;
-	}
-    queue->tail->next = newNode;   
-    queue->tail = newNode; 
+void setIndexType(struct problem *p, enum indexType index) {
+	p->index = index;
 }
 
 /*
-    Frees queue.
+	Makes the solvers search the given prebuilt index, such as one mapped 
+	with mapIndexFile, instead of building their own. The index stays owned 
+	by the caller.
 */
-void freeQueue(struct queue *queue) {
-    if (!queue->head) {
-		free(queue);
-		return;
-	}
-    while (!queue->head) {
-        struct node *curr = queue->head;
-        queue->head = queue->head->next;
-        free(curr);
-    }
-	free(queue);
+void useDictionaryIndex(struct problem *p, struct prefixTree *index) {
+	p->sharedIndex = index;
 }
 
 /* Frees data ****************************************************************/
@@ -490,11 +2131,11 @@ void freeSolution(struct solution *solution, struct problem *problem){
 		if(solution->followLetters){
 			free(solution->followLetters);
 		}
-		if(solution->words){
-			for (int i = 0; i < solution->foundWordCount; i++) {
-				free(solution->words[i]); 
-			}
-			free(solution->words);
+		if(solution->wordNumbers){
+			free(solution->wordNumbers);
+		}
+		if(solution->ownsIndex){
+			freeTree(solution->index);
 		}
 		free(solution);
 	}
@@ -506,13 +2147,11 @@ void freeSolution(struct solution *solution, struct problem *problem){
 void freeProblem(struct problem *problem){
 	if(problem){
 		if(problem->words){
-			for(int i = 0; i < problem->wordCount; i++){
-				if(problem->words[i]){
-					free(problem->words[i]);
-				}
-			}
 			free(problem->words);
 		}
+		if(problem->wordText){
+			free(problem->wordText);
+		}
 		if(problem->board){
 			free(problem->board);
 		}
@@ -540,16 +2179,42 @@ void freeProblem(struct problem *problem){
 	and the given board file into a nxn board.
 */
 struct problem *readProblemA(FILE *dictFile, FILE *boardFile){
+	struct problem *p = readDictionary(dictFile);
+	readBoard(p, boardFile);
+	return p;
+}
+
+/*
+	Reads the given dict file into a list of words, leaving the board empty.
+	A NULL file gives an empty dictionary, for use with a loaded index.
+	
+	The file is read once and split in place: every word is a string inside
+	the one text buffer, so parsing is a single linear pass.
+*/
+struct problem *readDictionary(FILE *dictFile){
 	struct problem *p = (struct problem *) malloc(sizeof(struct problem));
 	assert(p);
 
-	/* Part B onwards so set as empty. */
+	/* Board and Part B onwards so set as empty. */
+	p->dimension = 0;
+	p->boardFlat = NULL;
+	p->board = NULL;
 	p->partialString = NULL;
+	p->partialSize = 0;
+	p->part = PART_A;
+	p->index = INDEX_TRIE;
+	p->sharedIndex = NULL;
+	p->threads = 1;
+
+	p->wordCount = 0;
+	p->words = NULL;
+	p->wordText = NULL;
+	p->wideLetterCount = 0;
+	if(!dictFile){
+		return p;
+	}
 
-	int wordCount = 0;
-	int wordAllocated = 0;
 	char *dictText = NULL;
-	char **words = NULL;
 
 	/* Read in text. */
 	size_t allocated = 0;
@@ -565,10 +2230,59 @@ struct problem *readProblemA(FILE *dictFile, FILE *boardFile){
 		assert(success > 0);
 	}
 
+	char *end = dictText + strlen(dictText);
+
+	/* First line holds the number of words, it must be present. */
+	char *progress;
+	strtol(dictText, &progress, 10);
+	assert(progress > dictText);
+
+	/* Each line holds at most one word, so lines bound the word count. */
+	int lineCount = 1;
+	for(char *c = progress; (c = memchr(c, '\n', end - c)); c++){
+		lineCount++;
+	}
+	char **words = (char **) malloc(sizeof(char *) * lineCount);
+	assert(words);
+
+	/* A word runs from its first non-space character to the end of its 
+		line, blank lines are skipped. */
+	int wordCount = 0;
+	while(progress < end){
+		while(progress < end && isspace((unsigned char) *progress)){
+			progress++;
+		}
+		if(progress == end){
+			break;
+		}
+		char *lineEnd = memchr(progress, '\n', end - progress);
+		if(!lineEnd){
+			lineEnd = end;
+		}
+		*lineEnd = NULL_CHAR;
+		words[wordCount++] = progress;
+		progress = lineEnd + 1;
+	}
+	assert(wordCount <= lineCount);
+
+	/* The number of words in the text. */
+	p->wordCount = wordCount;
+	/* The list of words in the dictionary, all within wordText. */
+	p->words = words;
+	p->wordText = dictText;
+	return p;
+}
+
+/*
+	Reads the given board file into a nxn board, checking every row has as 
+	many letters as the first while the letters are copied out in one pass.
+	A letter is a byte a to z or A to Z, or any UTF-8 character of several 
+	bytes, which the board holds as one byte standing for it.
+*/
+static void readBoard(struct problem *p, FILE *boardFile){
 	char *boardText = NULL;
-	/* Reset allocated marker. */
-	allocated = 0;
-	success = getdelim(&boardText, &allocated, '\0', boardFile);
+	size_t allocated = 0;
+	int success = getdelim(&boardText, &allocated, '\0', boardFile);
 
 	if(success == -1){
 		/* Encountered an error. */
@@ -579,119 +2293,46 @@ struct problem *readProblemA(FILE *dictFile, FILE *boardFile){
 		assert(success > 0);
 	}
 
-	/* Progress through string. */
-	int progress = 0;
-	/* Table string length. */
-	int dictTextLength = strlen(dictText);
-
-	/* Count words present. */
-	while(progress < dictTextLength){
-		char *word = NULL;
-		int nextProgress;
-		/* Read each value into the dictionary. */
-		if(progress == 0){
-			/* First line. */
-			int wordNumberGuess;
-			assert(sscanf(dictText + progress, "%d %n", &wordNumberGuess, 
-                          &nextProgress) == 1);
-			/* Will fail if integer missing from the start of the words. */
-			assert(nextProgress > 0);
-			if(wordNumberGuess > 0){
-				wordAllocated = wordNumberGuess;
-				words = (char **) malloc(sizeof(char *) * wordAllocated);
-				assert(words);
-			}
-			progress += nextProgress;
-			continue;
-		} else {
-			assert(sscanf(dictText + progress, "%m[^\n] %n", &word, 
-                          &nextProgress) == 1);
-			assert(nextProgress > 0);
-			progress += nextProgress;
-		}
-
-		/* Check if more space is needed to store the word. */
-		if(wordAllocated <= 0){
-			words = (char **) malloc(sizeof(char *) * INITIALWORDSALLOCATION);
-			assert(words);
-			wordAllocated = INITIALWORDSALLOCATION;
-		} else if(wordCount >= wordAllocated){
-			words = (char **) realloc(words, sizeof(char *) * 
-				wordAllocated * 2);
-			assert(words);
-			wordAllocated = wordAllocated * 2;
-			/* Something has gone wrong if there's not sufficient word 
-				space for another word. */
-			assert(wordAllocated > wordCount);
-		}
-
-		words[wordCount] = word;
-		wordCount++;
-	}
-	
-	/* Done with dictText */
-	if(dictText){
-		free(dictText);
-	}
-	
-	/* Now read in board */
-	progress = 0;
+	/* Letters are compacted to the front of the text as they are read. */
+	char *letters = boardText;
+	int letterCount = 0;
 	int dimension = 0;
-	int boardTextLength = strlen(boardText);
-	/* Count dimension with first line */
-	while(progress < boardTextLength){
-		/* Count how many non-space characters appear in line. */
-		if(boardText[progress] == '\n' || boardText[progress] == '\0'){
-			/* Reached end of line. */
-			break;
-		}
-		if(isalpha(boardText[progress])){
-			dimension++;
-		}
-		progress++;
-	}
-
-	assert(dimension > 0);
-
-	/* Check each line has the correct dimension. */
-	for(int i = 1; i < dimension; i++){
-		int rowDim = 0;
-		if(boardText[progress] == '\n'){
-			progress++;
-		}
-		while(progress < boardTextLength){
-			/* Count how many non-space characters appear in line. */
-			if(boardText[progress] == '\n' || boardText[progress] == '\0'){
-				/* Reached end of line. */
-				break;
+	int row = 0;
+	int rowDim = 0;
+	for(char *c = boardText; ; c++){
+		if(*c == '\n' || *c == NULL_CHAR){
+			/* Reached end of line, the first one sets the dimension. */
+			if(row == 0){
+				dimension = rowDim;
+				assert(dimension > 0);
+			} else if(rowDim != dimension){
+				fprintf(stderr, 
+				"Row #%d had %d letters, different to Row #1's %d letters.\n", 
+                    	row + 1, rowDim, dimension);
+				assert(rowDim == dimension);
 			}
-			if(isalpha(boardText[progress])){
-				rowDim++;
+			row++;
+			rowDim = 0;
+			if(*c == NULL_CHAR || row == dimension){
+				break;
 			}
-			progress++;
-		}
-		if(rowDim != dimension){
-			fprintf(stderr, 
-			"Row #%d had %d letters, different to Row #1's %d letters.\n", 
-                    i + 1, rowDim, dimension);
-			assert(rowDim == dimension);
+		} else if(isalpha((unsigned char) *c)){
+			letters[letterCount++] = *c;
+			rowDim++;
+		} else if(symbolLength(c) > 1){
+			/* A UTF-8 letter takes one cell, so one byte of the text. */
+			int length = symbolLength(c);
+			letters[letterCount++] = wideBoardLetter(p, c, length);
+			rowDim++;
+			c += length - 1;
 		}
 	}
+	assert(row == dimension);
 
 	/* Define board. */
-	char *boardFlat = (char *) malloc(sizeof(char) * dimension * dimension);
+	char *boardFlat = (char *) realloc(boardText, 
+									   sizeof(char) * dimension * dimension);
 	assert(boardFlat);
-	
-	/* Reset progress. */
-	progress = 0;
-	for(int i = 0; i < dimension; i++){
-		for(int j = 0; j < dimension; j++){
-			int nextProgress;
-			assert(sscanf(boardText + progress, "%c %n", 
-                          &boardFlat[i * dimension + j], &nextProgress) == 1);
-			progress += nextProgress;
-		}
-	}
 
 	char **board = (char **) malloc(sizeof(char **) * dimension);
 	assert(board);
@@ -699,22 +2340,51 @@ struct problem *readProblemA(FILE *dictFile, FILE *boardFile){
 		board[i] = &boardFlat[i * dimension];
 	}
 
-	// fprintf(stderr, "\n");
-
-	/* The number of words in the text. */
-	p->wordCount = wordCount;
-	/* The list of words in the dictionary. */
-	p->words = words;
 	/* The dimension of the board (number of rows) */
 	p->dimension = dimension;
 	/* The board, represented both as a 1-D list and a 2-D list */
 	p->boardFlat = boardFlat;
 	p->board = board;
-	/* For Part B only. */
-	p->partialString = NULL;
-	p->part = PART_A;
-	free(boardText);
-	return p;
+}
+
+/*
+	Returns the board byte standing for the UTF-8 letter of length bytes, 
+	WIDE_LETTER_BASE plus its index in the problem's wide letters.
+*/
+static char wideBoardLetter(struct problem *p, const char *text, int length){
+	int i;
+	for(i = 0; i < p->wideLetterCount; i++){
+		if(strncmp(p->wideLetters[i], text, length) == 0 && 
+		   p->wideLetters[i][length] == NULL_CHAR){
+			return (char) (WIDE_LETTER_BASE + i);
+		}
+	}
+	if(p->wideLetterCount == MAX_WIDE_LETTERS){
+		fprintf(stderr, "Board has more than %d distinct UTF-8 letters.\n", 
+			MAX_WIDE_LETTERS);
+		exit(EXIT_FAILURE);
+	}
+	memcpy(p->wideLetters[i], text, length);
+	p->wideLetters[i][length] = NULL_CHAR;
+	p->wideLetterCount++;
+	return (char) (WIDE_LETTER_BASE + i);
+}
+
+/*
+	Returns the code in the alphabet of the letter a board byte stands for, 
+	folded to lower case, NO_SYMBOL if the alphabet does not hold it.
+*/
+static int boardLetterCode(struct problem *p, const struct alphabet *a, 
+	unsigned char letter){
+	if(letter < WIDE_LETTER_BASE){
+		char c = (char) letter;
+		return foldedSymbolCode(a, &c, 1);
+	}
+	if(letter - WIDE_LETTER_BASE >= p->wideLetterCount){
+		return NO_SYMBOL;
+	}
+	char *text = p->wideLetters[letter - WIDE_LETTER_BASE];
+	return foldedSymbolCode(a, text, strlen(text));
 }
 
 struct problem *readProblemB(FILE *dictFile, FILE *boardFile, 
@@ -738,33 +2408,56 @@ struct problem *readProblemD(FILE *dictFile, FILE *boardFile){
 	/* Interpretation of inputs is same as Part A. */
 	struct problem *p = readProblemA(dictFile, boardFile);
 	p->part = PART_D;
+	dropRepeatedLetterWords(p);
 	return p;
 }
 
 /* Outputs problems ***********************************************************/
 /*
-	Outputs the given solution to the given file. If colourMode is 1, the
-	sentence in the problem is coloured with the given solution colours.
+	Outputs the given solution to the given file in a single buffered write.
 */
 void outputProblem(struct problem *problem, struct solution *solution, 
 	FILE *outfileName){
+	struct outputBuffer *b = newOutputBuffer();
+	appendSolution(b, problem, solution);
+	if(fwrite(b->text, 1, b->length, outfileName) != b->length){
+		perror("Encountered error writing solution");
+		exit(EXIT_FAILURE);
+	}
+	freeOutputBuffer(b);
+}
+
+/*
+	Appends the given solution to the output buffer, one line per word or 
+	follow letter.
+*/
+void appendSolution(struct outputBuffer *b, struct problem *problem, 
+	struct solution *solution){
 	assert(solution);
 	switch(problem->part){
 		case PART_A:
 		case PART_D:
-			assert(solution->foundWordCount == 0 || solution->words);
+			assert(solution->foundWordCount == 0 || solution->wordNumbers);
 			for(int i = 0; i < solution->foundWordCount; i++){
-				fprintf(outfileName, "%s\n", solution->words[i]);
+				int w = solution->wordNumbers[i];
+				appendOutput(b, getWord(solution->index, w), 
+							 getWordLength(solution->index, w));
+				appendOutputChar(b, '\n');
 			}
 			break;
 		case PART_B:
 			assert(solution->foundLetterCount == 0 || solution->followLetters);
+			/* follow letters are codes of the index's alphabet */
 			for(int i = 0; i < solution->foundLetterCount; i++){
-				if(isalpha(solution->followLetters[i])){
-					fprintf(outfileName, "%c\n", solution->followLetters[i]);
+				int code = (unsigned char) solution->followLetters[i];
+				const struct alphabet *a = &solution->index->alphabet;
+				if(code != NO_SYMBOL && isPrintedSymbol(a, code)){
+					appendOutput(b, symbolText(a, code), 
+								 strlen(symbolText(a, code)));
 				} else {
-					fprintf(outfileName, " \n");
+					appendOutputChar(b, ' ');
 				}
+				appendOutputChar(b, '\n');
 			}
 			break;
 	}
@@ -3,23 +3,41 @@
         data structures and functions.
 */
 #include <stdio.h>
+#include <stdint.h>
 #include "prefixTree.h"
 
 struct problem;
 struct solution;
-struct node;
+struct solverContext;
+struct outputBuffer;
+struct scoreTable;
+struct scoreBounds;
+struct boardScore;
+struct hintSession;
 
-/* node data structure with next pointer and point to character array */
-struct node {
-    struct node *next;
-    char *item;
-};
+#ifndef WORDCONSUMER_DEF
+#define WORDCONSUMER_DEF 1
+/* 
+    Receives each word a streamed search finds, the moment it is first found:
+    its word number, the word itself, which stays valid as long as the index,
+    and the board cells spelling it in order, each row * dimension + column.
+    pathLength is also the length of the word. Returning false stops the 
+    search.
+*/
+typedef bool (*wordConsumer)(void *arg, int wordNumber, const char *word, 
+    const int *path, int pathLength);
+#endif
 
-/* queue data structure with head and tail pointers */
-struct queue {
-    struct node *head;
-    struct node *tail;
+#ifndef INDEXTYPEENUM_DEF
+#define INDEXTYPEENUM_DEF 1
+/* Dictionary index the solvers build and search */
+enum indexType {
+    /* Prefix tree, the default */
+    INDEX_TRIE = 0,
+    /* Minimal DAWG, which also shares common suffixes */
+    INDEX_DAWG = 1
 };
+#endif
 
 /* 
     Reads the given dictionary file into a set of words
@@ -27,6 +45,12 @@ struct queue {
 */
 struct problem *readProblemA(FILE *dictFile, FILE *boardFile);
 
+/*
+    Reads only the given dictionary file into a set of words, for building an
+        index. A NULL file gives an empty dictionary.
+*/
+struct problem *readDictionary(FILE *dictFile);
+
 /* 
     Reads the given dictionary file into a set of words,
         the given board file into a 1-D and 2-D representation and
@@ -36,10 +60,29 @@ struct problem *readProblemB(FILE *dictFile, FILE *boardFile,
     FILE *partialStringFile);
 
 /*
-    Same as Problem A, but part is set for Part D.
+    Same as Problem A, but part is set for Part D, and the dictionary words 
+    which repeat a letter are dropped, as part D can never find them.
 */
 struct problem *readProblemD(FILE *dictFile, FILE *boardFile);
 
+/*
+    Drops the dictionary words which repeat a letter, for a dictionary only
+    searched under part D's definitions, before its index is built.
+*/
+void dropRepeatedLetterWords(struct problem *p);
+
+/*
+    Selects the dictionary index used when solving the problem.
+*/
+void setIndexType(struct problem *p, enum indexType index);
+
+/*
+    Makes the solvers use the given prebuilt index (e.g. from mapIndexFile) 
+    rather than building one from the problem's words. The caller keeps 
+    ownership, so the dictionary file given when reading may be NULL.
+*/
+void useDictionaryIndex(struct problem *p, struct prefixTree *index);
+
 /*
     Solves the given problem according to all parts' definitions
     and places the solution output into a returned solution value.
@@ -50,12 +93,173 @@ struct solution *solveProblemB(struct problem *p);
 
 struct solution *solveProblemD(struct problem *p);
 
+/*
+    Creates a solver context holding the dictionary index of the given 
+    problem (its words, or the index given to useDictionaryIndex), so many 
+    boards can be solved without rebuilding it.
+*/
+struct solverContext *newSolverContext(struct problem *dictionary);
+
+/*
+    Creates a solver context searching the given caller-owned index. Each 
+    context has its own search scratch, so contexts sharing an index may be
+    used from different threads.
+*/
+struct solverContext *newSolverContextFromIndex(struct prefixTree *index);
+
+/*
+    Solves the board (and for part B the partial string) of the given problem
+    with the context's dictionary, ignoring the problem's own words. Parts A
+    and D search boards of more than 64 cells a side in tiles, each on a 
+    window just wider than the longest word, so the context's scratch is 
+    the size of a window whatever the board's size. A board no larger than
+    such a window is searched whole, its scratch growing with its area.
+*/
+struct solution *solveBoardA(struct solverContext *ctx, struct problem *p);
+
+struct solution *solveBoardB(struct solverContext *ctx, struct problem *p);
+
+struct solution *solveBoardD(struct solverContext *ctx, struct problem *p);
+
+/*
+    Starts a part B hint session on the board of the given problem, for a 
+    partial string typed a letter at a time, starting with the problem's 
+    partial string if it has one. The session keeps the board cells where 
+    the paths spelling each prefix of the partial string end, so typing or 
+    deleting a letter only updates those, whatever the dictionary size. The
+    context must not search another board while the session is in use, and
+    the problem must outlive it.
+*/
+struct hintSession *newHintSession(struct solverContext *ctx, 
+    struct problem *p);
+
+/*
+    Types one more letter of the partial string, the single or multi-byte 
+    UTF-8 character letter starts with, such as "e", "é" or "ж".
+*/
+void appendHintLetter(struct hintSession *s, const char *letter);
+
+/*
+    Deletes the last letter typed, if any.
+*/
+void deleteHintLetter(struct hintSession *s);
+
+/*
+    Returns the part B solution for the partial string typed so far, the 
+    same solveBoardB gives for it.
+*/
+struct solution *getSessionHints(struct hintSession *s);
+
+/*
+    Frees the hint session, but not its context.
+*/
+void freeHintSession(struct hintSession *s);
+
+/*
+    Solves the board of the given part B problem for each of count partial 
+    strings in one pass, sharing the search of the prefixes they have in 
+    common. Returns the solutions in the order of the partial strings, each
+    as solveBoardB gives it for that string and freed with freeSolution.
+*/
+struct solution **solveBoardMultiB(struct solverContext *ctx, 
+    struct problem *p, char **partialStrings, int count);
+
+/*
+    Searches the board like solveBoardA/solveBoardD, but hands each word to 
+    consumer, with arg, as soon as it is first found instead of building a 
+    solution, so words arrive in the order they are found. Returns false if 
+    the consumer stopped the search early. solveBoardA and solveBoardD are 
+    built on the same search, collecting the words and sorting them, but 
+    unlike them a stream always searches the whole board at once.
+*/
+bool streamBoardA(struct solverContext *ctx, struct problem *p, 
+    wordConsumer consumer, void *arg);
+
+bool streamBoardD(struct solverContext *ctx, struct problem *p, 
+    wordConsumer consumer, void *arg);
+
+/*
+    Scores the board like solveBoardA/solveBoardD with the given table: the
+    total and count of the distinct words found and the best topLimit of 
+    them, without building a solution.
+*/
+struct boardScore *scoreBoardA(struct solverContext *ctx, struct problem *p,
+    const struct scoreTable *table, int topLimit);
+
+struct boardScore *scoreBoardD(struct solverContext *ctx, struct problem *p,
+    const struct scoreTable *table, int topLimit);
+
+/*
+    Returns the best score of any word on the board under part A's 
+    definitions, or -1 if there is none, and sets bestWord to its word 
+    number, the first in order on a tie. bounds must be computed for the 
+    context's index. Only the best word is looked for, so every subtree 
+    whose bound cannot beat it is skipped.
+*/
+int bestScoreBoardA(struct solverContext *ctx, struct problem *p, 
+    struct scoreBounds *bounds, int *bestWord);
+
+/*
+    Hands consumer every path spelling a word under part A's definitions, 
+    so a word is handed over once per path spelling it.
+*/
+void walkPathsA(struct solverContext *ctx, struct problem *p, 
+    wordConsumer consumer, void *arg);
+
+/*
+    Walks the paths through one cell as walkPathsA does, both with its 
+    current letter, handed to removed, and with the given letter, handed to
+    added, without changing the board. So the path counts of walkPathsA 
+    follow a change of the cell's letter by searching only the paths 
+    through it. reversePrefixes is newReversePrefixDawg of the context's 
+    index, which lets the word prefixes grow backwards from the cell.
+*/
+void walkLetterChangeA(struct solverContext *ctx, struct problem *p, 
+    struct prefixTree *reversePrefixes, int cell, char letter, 
+    wordConsumer removed, wordConsumer added, void *arg);
+
+/*
+    Changes the letter of one board cell, row * dimension + column.
+*/
+void setBoardLetter(struct problem *p, int cell, char letter);
+
+/*
+    Solves the board of the given problem like solveBoardA/solveBoardD, with
+    the search split into independent root letter and start cell tasks run 
+    on threadCount threads. contexts holds one context per thread, all 
+    sharing one index. Boards of more than 64 cells a side are split into 
+    tiles instead, one task per tile, when a tile's window is smaller than
+    the board. Results are the same as the serial solvers.
+*/
+struct solution *solveBoardParallelA(struct solverContext **contexts, 
+    int threadCount, struct problem *p);
+
+struct solution *solveBoardParallelD(struct solverContext **contexts, 
+    int threadCount, struct problem *p);
+
+/*
+    Sets how many threads solveProblemA and solveProblemD use, default 1.
+*/
+void setSolverThreads(struct problem *p, int threads);
+
+/*
+    Frees the given solver context, and its index if the context built it.
+*/
+void freeSolverContext(struct solverContext *ctx);
+
 /*
     Outputs the given solution to the given file.
 */
 void outputProblem(struct problem *problem, struct solution *solution, 
     FILE *outfileName);
 
+/*
+    Appends the given solution to the given output buffer, in the same format
+    outputProblem writes.
+*/
+void appendSolution(struct outputBuffer *b, struct problem *problem, 
+    struct solution *solution);
+
 /*
     Frees the given solution and all memory allocated for it.
 */
@@ -66,26 +270,21 @@ void freeSolution(struct solution *solution, struct problem *problem);
 */
 void freeProblem(struct problem *problem);
 
-/*
-    Gets all neighbours of current piece in board. Check if current letter in 
-    tree is part of neighbours. If so, enqueue the neighbour. For all parts A-D.
-    Time complexity of O(1).
-*/
-void getNeighbour(char *charInBoard, int treeIndex, struct problem *p, 
-                  struct queue *q);
-
 /*
     Explores both prefix tree and letters in board simultaneously using
-    depth-first search approach and queue data structure.
+    depth-first search approach, starting from root child t at the given 
+    board cell. The searches of all three parts, the best word search and
+    the path walks run on one iterative search whose stack holds a frame 
+    per letter of the longest word, with part A on boards of at most 64 
+    cells keeping its own recursive search.
 */
-void treeExploreA(struct prefixTree *t, struct solution *s, char *charInBoard, 
-    struct problem *p, bool *visited);
+void treeExploreA(struct solverContext *ctx, struct trieNode *t, int base,
+    int cell, struct problem *p);
 
-void treeExploreB(struct prefixTree *t, struct solution *s, char *charInBoard, 
-    int partialIndex, struct problem *p, struct prefixTree **partialStringEnd);
+void treeExploreB(struct solverContext *ctx, struct trieNode *t, int cell);
 
-void treeExploreD(struct prefixTree *t, struct solution *s, char *charInBoard,
-    struct problem *p, bool *visited);
+void treeExploreD(struct solverContext *ctx, struct trieNode *t, int base,
+    int cell);
 
 /*
     Add all words into prefix tree.
@@ -93,26 +292,20 @@ void treeExploreD(struct prefixTree *t, struct solution *s, char *charInBoard,
 void addDictionaryToTree(struct prefixTree *t, struct problem *p);
 
 /*
-    Inserts found word into solution (parts A-D) via DFS on prefix tree.
-*/
-void exploreSolutions(struct prefixTree*t, struct solution*s, struct problem*p);
-
-/*
-    Create new queue.
-*/
-struct queue *createQueue();
-
-/* 
-    Removes and return the item in the front-most node.
+    Builds the dictionary index selected for the problem (prefix tree or DAWG).
 */
-char *dequeue(struct queue *queue);
+struct prefixTree *buildDictionaryIndex(struct problem *p);
 
 /*
-    Inserts new node into queue.
+    Inserts found words into solution (parts A and D) in word number order,
+    given the hitCount word numbers found in any order.
 */
-void enqueue(struct queue *queue, char *word);
+void collectSolutions(struct prefixTree *t, int *hits, int hitCount, 
+    struct solution *s);
 
 /*
-    Frees queue.
+    Inserts found follow letters into solution (part B), as letter codes of
+    the solution's index, given the partial string's length in letters.
 */
-void freeQueue(struct queue *queue);
+void collectFollowLetters(int partialLength, bool *prefixEnd, 
+    bool *followFound, struct solution *s);
@@ -16,11 +16,17 @@ enum problemPart {
 };
 #endif
 
+/* Board bytes from WIDE_LETTER_BASE stand for the board's UTF-8 letters */
+#define WIDE_LETTER_BASE 0x80
+#define MAX_WIDE_LETTERS 128
+
 struct problem {
     /* The number of words in the text. */
     int wordCount;
     /* The list of words in the dictionary. */
     char **words;
+    /* Dictionary text the words point into. */
+    char *wordText;
 
     /* The dimension of the board (number of rows) */
     int dimension;
@@ -28,6 +34,10 @@ struct problem {
     /* The board, represented both as a 1-D list and a 2-D list */
     char *boardFlat;
     char **board;
+    /* UTF-8 letters of the board, the letter of a board byte b from 
+        WIDE_LETTER_BASE being wideLetters[b - WIDE_LETTER_BASE]. */
+    char wideLetters[MAX_WIDE_LETTERS][MAX_SYMBOL_BYTES + 1];
+    int wideLetterCount;
 
     /* For Part B only, the partial string. */
     char *partialString;
@@ -36,6 +46,13 @@ struct problem {
 
     /* Which problem part is being solved. */
     enum problemPart part;
+
+    /* Which dictionary index the solvers build. */
+    enum indexType index;
+    /* Prebuilt index to search instead, owned by the caller. */
+    struct prefixTree *sharedIndex;
+    /* Number of threads parts A and D search the board with. */
+    int threads;
 };
 
 
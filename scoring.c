@@ -0,0 +1,245 @@
+/*    
+     Implementation for module which scores words and bounds the scores 
+        reachable below dictionary index nodes.
+*/
+#include "scoring.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Marks a node whose bounds are not computed yet */
+#define NO_BOUND (-1)
+
+/* Classic points by word length, 8 letters or more score 11 */
+static const int classicPoints[SCORE_LENGTHS] = {
+    0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11
+};
+
+/* Scrabble tile values of the letters a to z */
+static const int tileValues[] = {
+    1, 3, 3, 2, 1, 4, 2, 4, 1, 8, 5, 1, 3, 
+    1, 1, 3, 10, 1, 1, 1, 1, 4, 4, 8, 4, 10
+};
+
+/* Computes the bounds of node and everything below it, if not done yet */
+static void boundNode(struct scoreBounds *b, struct prefixTree *t, int node);
+/* Whether kept word i ranks below kept word j */
+static bool ranksBelow(struct boardScore *s, int i, int j);
+/* Restores the kept words below i to a heap with the lowest ranked on top */
+static void siftDown(struct boardScore *s, int i, int count);
+
+/*******************************************************/
+/*
+    Fills the classic Boggle table.
+*/
+void classicScoreTable(struct scoreTable *table) {
+    memset(table, 0, sizeof(struct scoreTable));
+    memcpy(table->lengthPoints, classicPoints, sizeof(classicPoints));
+}
+
+/*
+    Fills a letter sum table from Scrabble tile values.
+*/
+void letterSumScoreTable(struct scoreTable *table) {
+    memset(table, 0, sizeof(struct scoreTable));
+    for (int c = 0; c < (int) (sizeof(tileValues) / sizeof(int)); c++) {
+        table->letterPoints['a' + c] = tileValues[c];
+        table->letterPoints['A' + c] = tileValues[c];
+    }
+}
+
+/*
+    Computes the score bounds of every node of the index for the table.
+*/
+struct scoreBounds *newScoreBounds(struct prefixTree *t, 
+                                   const struct scoreTable *table) {
+    struct scoreBounds *b = (struct scoreBounds *) 
+        malloc(sizeof(struct scoreBounds));
+    assert(b);
+    b->table = table;
+    /* a letter of several bytes scores each of them, as in scoreWord */
+    memset(b->codePoints, 0, sizeof(b->codePoints));
+    for (int code = 1; code <= t->alphabet.symbolCount; code++) {
+        for (const char *c = symbolText(&t->alphabet, code); *c; c++) {
+            b->codePoints[code] += table->letterPoints[(unsigned char) *c];
+        }
+    }
+    b->suffixPoints = (int *) malloc(sizeof(int) * t->nodeCount);
+    b->suffixLength = (int *) malloc(sizeof(int) * t->nodeCount);
+    assert(b->suffixPoints && b->suffixLength);
+    for (int i = 0; i < t->nodeCount; i++) {
+        b->suffixLength[i] = NO_BOUND;
+    }
+    boundNode(b, t, ROOT_NODE);
+
+    int best = table->lengthPoints[0];
+    for (int length = 0; length < SCORE_LENGTHS; length++) {
+        if (table->lengthPoints[length] > best) {
+            best = table->lengthPoints[length];
+        }
+        b->lengthBest[length] = best;
+    }
+    return b;
+}
+
+/*
+    Computes the bounds of node from those of its children. A DAWG node is
+    reached through several parents but computed once.
+*/
+static void boundNode(struct scoreBounds *b, struct prefixTree *t, int node) {
+    if (b->suffixLength[node] != NO_BOUND) {
+        return;
+    }
+    struct trieNode *n = &t->nodes[node];
+    /* a node always ends or leads to some word */
+    int points = 0;
+    int length = 0;
+    for (struct trieNode *c = getFirstChild(t, n); c; 
+         c = getNextSibling(t, c)) {
+        int child = c - t->nodes;
+        boundNode(b, t, child);
+        int childPoints = b->codePoints[(unsigned char) c->letter] + 
+            b->suffixPoints[child];
+        if (childPoints > points) {
+            points = childPoints;
+        }
+        if (b->suffixLength[child] + 1 > length) {
+            length = b->suffixLength[child] + 1;
+        }
+    }
+    b->suffixPoints[node] = points;
+    b->suffixLength[node] = length;
+}
+
+/*
+    Creates an empty board score keeping the best topLimit words.
+*/
+struct boardScore *newBoardScore(int topLimit) {
+    struct boardScore *s = (struct boardScore *) 
+        malloc(sizeof(struct boardScore));
+    assert(s);
+    s->table = NULL;
+    s->total = 0;
+    s->wordCount = 0;
+    s->topCount = 0;
+    s->topLimit = topLimit;
+    s->topWords = (int *) malloc(sizeof(int) * (topLimit + 1));
+    s->topScores = (int *) malloc(sizeof(int) * (topLimit + 1));
+    assert(s->topWords && s->topScores);
+    return s;
+}
+
+/*
+    Adds a word to the total, and keeps it if it ranks above the lowest 
+    ranked of the kept words, which a heap keeps on top.
+*/
+void addWordScore(struct boardScore *s, int wordNumber, int score) {
+    s->total += score;
+    s->wordCount++;
+    if (s->topLimit == 0) {
+        return;
+    }
+    int i;
+    if (s->topCount < s->topLimit) {
+        /* sift the new word up from the bottom */
+        i = s->topCount++;
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (s->topScores[parent] < score || 
+                (s->topScores[parent] == score && 
+                 s->topWords[parent] < wordNumber)) {
+                break;
+            }
+            s->topWords[i] = s->topWords[parent];
+            s->topScores[i] = s->topScores[parent];
+            i = parent;
+        }
+        s->topWords[i] = wordNumber;
+        s->topScores[i] = score;
+        return;
+    }
+    if (score < s->topScores[0] || 
+        (score == s->topScores[0] && wordNumber > s->topWords[0])) {
+        return;
+    }
+    s->topWords[0] = wordNumber;
+    s->topScores[0] = score;
+    siftDown(s, 0, s->topCount);
+}
+
+/*
+    Sorts the kept words best first by taking the lowest ranked off the 
+    heap into the last free place until it is empty.
+*/
+void finishBoardScore(struct boardScore *s) {
+    for (int count = s->topCount - 1; count > 0; count--) {
+        int word = s->topWords[0];
+        int score = s->topScores[0];
+        s->topWords[0] = s->topWords[count];
+        s->topScores[0] = s->topScores[count];
+        s->topWords[count] = word;
+        s->topScores[count] = score;
+        siftDown(s, 0, count);
+    }
+}
+
+/*
+    Whether kept word i ranks below kept word j: a lower score, or the same 
+    score and a later word.
+*/
+static bool ranksBelow(struct boardScore *s, int i, int j) {
+    return s->topScores[i] < s->topScores[j] || 
+        (s->topScores[i] == s->topScores[j] && s->topWords[i] > s->topWords[j]);
+}
+
+/*
+    Moves kept word i down the heap of the first count kept words until no
+    child ranks below it.
+*/
+static void siftDown(struct boardScore *s, int i, int count) {
+    while (true) {
+        int lowest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < count && ranksBelow(s, left, lowest)) {
+            lowest = left;
+        }
+        if (right < count && ranksBelow(s, right, lowest)) {
+            lowest = right;
+        }
+        if (lowest == i) {
+            return;
+        }
+        int word = s->topWords[i];
+        int score = s->topScores[i];
+        s->topWords[i] = s->topWords[lowest];
+        s->topScores[i] = s->topScores[lowest];
+        s->topWords[lowest] = word;
+        s->topScores[lowest] = score;
+        i = lowest;
+    }
+}
+
+/*
+    Frees the score bounds.
+*/
+void freeScoreBounds(struct scoreBounds *b) {
+    if (b) {
+        free(b->suffixPoints);
+        free(b->suffixLength);
+        free(b);
+    }
+}
+
+/*
+    Frees a board score.
+*/
+void freeBoardScore(struct boardScore *s) {
+    if (s) {
+        free(s->topWords);
+        free(s->topScores);
+        free(s);
+    }
+}
@@ -0,0 +1,121 @@
+/*    
+     Header for module which scores words with pluggable score tables, and 
+        bounds the best score reachable below each dictionary index node so
+        a search for the best word can skip subtrees.
+*/
+#include "prefixTree.h"
+
+#ifndef SCORING_DEF
+#define SCORING_DEF
+
+/* Number of word lengths a score table lists, longer words score as the 
+    last one */
+#define SCORE_LENGTHS 17
+
+/* Points for a word: lengthPoints[length] plus the letterPoints of each 
+    of its letters, none of them negative */
+struct scoreTable {
+    int lengthPoints[SCORE_LENGTHS];
+    int letterPoints[MAX_CHAR];
+};
+
+/* Upper bounds on the score of any word through each node of one index */
+struct scoreBounds {
+    const struct scoreTable *table;
+    /* Letter points of each letter code of the index */
+    int codePoints[MAX_CHAR];
+    /* Most letter points and most letters any word adds after the node */
+    int *suffixPoints;
+    int *suffixLength;
+    /* Most length points of any length up to i */
+    int lengthBest[SCORE_LENGTHS];
+};
+
+/* Totals and best words of one board */
+struct boardScore {
+    /* Table the words are scored with */
+    const struct scoreTable *table;
+    /* Sum of the scores of all distinct words found */
+    long total;
+    int wordCount;
+    /* Best topCount of at most topLimit words, best first once finished: 
+        higher scores first, equal scores by ascending word number */
+    int topCount;
+    int topLimit;
+    int *topWords;
+    int *topScores;
+};
+
+/*
+    Fills the classic Boggle table: 1 point for 3 and 4 letter words, then 
+    2, 3 and 5 points for 5, 6 and 7 letters and 11 for 8 or more.
+*/
+void classicScoreTable(struct scoreTable *table);
+
+/*
+    Fills a letter sum table: every letter scores its Scrabble tile value,
+    whatever the length of the word.
+*/
+void letterSumScoreTable(struct scoreTable *table);
+
+/*
+    Returns the score of the given word of the given length in letters. A 
+    UTF-8 letter scores the points of each of its bytes.
+*/
+static inline int scoreWord(const struct scoreTable *table, const char *word,
+                            int length) {
+    int score = table->lengthPoints[length < SCORE_LENGTHS ? length : 
+                                    SCORE_LENGTHS - 1];
+    for (const char *c = word; *c; c++) {
+        score += table->letterPoints[(unsigned char) *c];
+    }
+    return score;
+}
+
+/*
+    Computes the score bounds of every node of the index for the table, 
+    which must outlive them. Bounds only depend on what lies below a node,
+    so they hold for DAWG nodes shared by several prefixes.
+*/
+struct scoreBounds *newScoreBounds(struct prefixTree *t, 
+                                   const struct scoreTable *table);
+
+/*
+    Returns an upper bound on the score of any word through node n, reached
+    by a prefix of the given length scoring prefixPoints letter points.
+*/
+static inline int scoreBound(struct scoreBounds *b, struct prefixTree *t, 
+                             struct trieNode *n, int length, 
+                             int prefixPoints) {
+    int node = n - t->nodes;
+    int longest = length + b->suffixLength[node];
+    return prefixPoints + b->suffixPoints[node] + 
+        b->lengthBest[longest < SCORE_LENGTHS ? longest : SCORE_LENGTHS - 1];
+}
+
+/*
+    Creates an empty board score keeping the best topLimit words.
+*/
+struct boardScore *newBoardScore(int topLimit);
+
+/*
+    Adds a distinct found word and its score to the board score.
+*/
+void addWordScore(struct boardScore *s, int wordNumber, int score);
+
+/*
+    Puts the kept words best first, after the last word is added.
+*/
+void finishBoardScore(struct boardScore *s);
+
+/*
+    Frees the score bounds.
+*/
+void freeScoreBounds(struct scoreBounds *b);
+
+/*
+    Frees a board score.
+*/
+void freeBoardScore(struct boardScore *s);
+
+#endif
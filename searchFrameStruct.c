@@ -0,0 +1,28 @@
+/*
+    Implementation for data structure used in keeping one frame of the 
+        stack of the iterative board search.
+*/
+/* One letter of the path of the iterative search: its node and cell, and
+    the cursor over the node's children and the neighbouring cells holding 
+    the letter of the child being tried. */
+struct searchFrame {
+    struct trieNode *node;
+    int base;
+    int cell;
+    /* Length of the path before the cell. */
+    int depth;
+    /* Part D, the usedLetterBit of every letter of the path up to here. */
+    uint64_t used;
+    /* Best word search, the letter points of the path up to here. */
+    int points;
+    /* Word number base of the node's children. */
+    int childBase;
+    struct trieNode *child;
+    /* Neighbour list of the cell, and the letter codes of the 
+        neighbours, one byte each in the order of the list. */
+    int *around;
+    uint64_t codes;
+    /* The top bit of the bytes of the neighbours holding the child's 
+        letter not tried yet. */
+    uint64_t next;
+};
@@ -0,0 +1,18 @@
+/*
+    Implementation for data structure used in telling the iterative board 
+        search the rules of one part.
+*/
+/* Rules of one part's search, which the iterative search follows. */
+struct searchRules {
+    /* Called as the path reaches the node of the frame, returns whether the
+        path may go on past it. */
+    bool (*reach)(struct solverContext *ctx, struct searchFrame *frame);
+    /* Returns the child of the frame's node to try after child, the first
+        one for NULL, or NULL once there are none left. */
+    struct trieNode *(*nextChild)(struct solverContext *ctx, 
+                                  struct searchFrame *frame, 
+                                  struct trieNode *child);
+    /* Whether a path never repeats a cell, kept in the context's visited 
+        bitset. */
+    bool distinctCells;
+};
@@ -12,12 +12,18 @@
 struct solution {
     /* The number of words which can be made. */
     int foundWordCount;
-    /* The list of words that can be made. */
-    char **words;
+    /* Word numbers of the words that can be made, in lexicographic order, 
+        exactly foundWordCount of them. */
+    int *wordNumbers;
+    /* The index the word numbers refer to, which must outlive the 
+        solution unless the solution owns it. */
+    struct prefixTree *index;
+    bool ownsIndex;
 
     /* Part B only */
     /* The number of letters which might follow. */
     int foundLetterCount;
-    /* The list of letters. */
+    /* The list of letters, as codes in the alphabet of the index, with 
+        NULL_CHAR for the end of a word. */
     char *followLetters;
 };
@@ -0,0 +1,77 @@
+/*
+    Implementation for data structure used in keeping a dictionary index 
+        across many searches, along with the scratch space each search 
+        needs so nothing is written into the shared index.
+*/
+struct solverContext {
+    /* The dictionary index, never changed by a search. */
+    struct prefixTree *index;
+    /* Whether the index is freed with the context. */
+    bool ownsIndex;
+
+    /* Parts A and D, the word numbers found so far in order of discovery, 
+        each once. */
+    int *hits;
+    int hitCount;
+    int hitAllocated;
+    /* Word number w has been found in the current search when 
+        foundStamp[w] == generation, so starting a search only takes a new
+        generation instead of clearing a stamp per dictionary word. */
+    uint32_t *foundStamp;
+    uint32_t generation;
+    /* Receives each word the current search finds, appendHit unless the 
+        search is streamed. The search stops once it returns false. */
+    wordConsumer consumer;
+    void *consumerArg;
+    bool stopped;
+    /* The best word search or path walk running, for its search rules. */
+    void *searchState;
+    /* Board cells of the current path, by depth. */
+    int *path;
+    /* Stack of the iterative search, one frame per letter of the index's 
+        longest word. */
+    struct searchFrame *frames;
+
+    /* Board bitsets below hold one bit per cell in boardWords words each, 
+        a single word for boards up to 8x8. */
+    int boardWords;
+    /* Part A, the board cells on the current path, for boards too large 
+        for a single word. */
+    uint64_t *visited;
+    /* The cells holding each letter code of the current board. */
+    uint64_t *letterMask;
+    /* The letter codes of the current board, the only ones with cells in 
+        letterMask. */
+    char heldLetters[MAX_CHAR];
+    int heldLetterCount;
+    /* Letter code of each byte of the current board. */
+    unsigned char boardCodes[MAX_CHAR];
+
+    /* Neighbours of each board cell, MAX_NEIGHBOURS per cell with the 
+        missing ones NO_CELL at the end, for boards of adjacencyDimension. 
+        Boards of a single bitset word also keep them as a board bitset per 
+        cell, NULL for larger boards. */
+    int *neighbours;
+    uint64_t *neighbourMask;
+    int adjacencyDimension;
+    /* Letter codes of the neighbours of each cell of the current board, 
+        one byte each in the order of its neighbour list, NO_SYMBOL for 
+        the missing ones. */
+    uint64_t *neighbourCodes;
+
+    /* Part B only */
+    /* Whether the first i letters of the partial string form a word. */
+    bool *prefixEnd;
+    int prefixEndSize;
+    /* Letter codes of the partial string, partialLength letters. */
+    char *partialCodes;
+    int partialLength;
+    /* Whether some word continues the partial string with each letter
+        code. */
+    bool followFound[MAX_CHAR];
+};
+
+/* Most neighbours a board cell can have, and the neighbour list entry of 
+    one it lacks */
+#define MAX_NEIGHBOURS 8
+#define NO_CELL (-1)
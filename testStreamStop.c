@@ -0,0 +1,146 @@
+/*
+	Checks that a streamed search stops as soon as its consumer asks it to.
+
+	Usage: testStreamStop
+
+	Random boards of several sizes are streamed under parts A and D with a
+	consumer which stops after a given number of words. The consumer must be
+	called exactly that many times, or once per word on the board if it has
+	fewer, and the stream must report whether it was stopped. The built in
+	dictionary holds every single letter, so each cell starts a word and a
+	search which carries on from the next cell after a stop is caught.
+	Exits with failure if any stream goes wrong.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "problem.h"
+
+#define DEFAULT_SEED 1
+/* Most words a consumer takes before stopping the search */
+#define MAX_LIMIT 40
+
+/* Every single letter, then words spelled often on random boards */
+static const char dictionaryText[] = "52\n"
+	"a\nb\nc\nd\ne\nf\ng\nh\ni\nj\nk\nl\nm\nn\no\np\nq\nr\ns\nt\nu\nv\nw\n"
+	"x\ny\nz\n"
+	"at\nate\neat\nea\ner\nera\nes\net\neta\nin\nit\nne\nnet\nno\nnot\non\n"
+	"one\nore\nra\nrat\nre\nrest\nset\nst\nta\nte\n";
+
+/* Board dimensions tried: standard, single bitset word and larger */
+static const int dimensions[] = {4, 5, 8, 10, 12};
+
+/* Board letters, each repeated by its rough frequency in English text */
+static char letters[] = "eeeeeeeeeeeettttttttttaaaaaaaaooooooooiiiiiii"
+	"nnnnnnnsssssssrrrrrrhhhhhhdddddlllllccccuuuummmwwffggyyppbbvkjxqz";
+
+/* Words a consumer takes before stopping, and how many it has been given */
+struct stopCount {
+	int limit;
+	int calls;
+};
+
+/* Consumer counting its calls and stopping once it reaches its limit */
+static bool countWord(void *arg, int wordNumber, const char *word,
+	const int *path, int pathLength);
+/* Writes a random board of the given dimension to a new string */
+static char *randomBoard(int dimension);
+/* Streams the problem's board stopping after every limit up to MAX_LIMIT,
+	returning the number of streams going wrong */
+static int checkStreams(struct solverContext *ctx, struct problem *p,
+	int dimension, bool (*stream)(struct solverContext *, struct problem *, 
+								  wordConsumer, void *), const char *part);
+
+int main(void){
+	srand(DEFAULT_SEED);
+	int failures = 0;
+	for(size_t i = 0; i < sizeof(dimensions) / sizeof(dimensions[0]); i++){
+		char *boardText = randomBoard(dimensions[i]);
+		FILE *dictFile = fmemopen((void *) dictionaryText,
+			strlen(dictionaryText), "r");
+		FILE *boardFile = fmemopen(boardText, strlen(boardText), "r");
+		if(!dictFile || !boardFile){
+			perror("Encountered error opening test board");
+			return EXIT_FAILURE;
+		}
+		struct problem *p = readProblemA(dictFile, boardFile);
+		fclose(dictFile);
+		fclose(boardFile);
+		struct solverContext *ctx = newSolverContext(p);
+
+		failures += checkStreams(ctx, p, dimensions[i], streamBoardA, "A");
+		failures += checkStreams(ctx, p, dimensions[i], streamBoardD, "D");
+
+		freeSolverContext(ctx);
+		freeProblem(p);
+		free(boardText);
+	}
+	if(failures > 0){
+		fprintf(stderr, "%d streams went wrong\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("All streams stopped when asked\n");
+	return EXIT_SUCCESS;
+}
+
+/*
+	Consumer counting its calls and stopping once it reaches its limit.
+*/
+static bool countWord(void *arg, int wordNumber, const char *word,
+	const int *path, int pathLength){
+	struct stopCount *count = (struct stopCount *) arg;
+	count->calls++;
+	return count->calls < count->limit;
+}
+
+/*
+	Streams the problem's board stopping after every limit up to MAX_LIMIT.
+	A full stream first counts the words on the board.
+*/
+static int checkStreams(struct solverContext *ctx, struct problem *p,
+	int dimension, bool (*stream)(struct solverContext *, struct problem *, 
+								  wordConsumer, void *), const char *part){
+	struct stopCount all = {INT_MAX, 0};
+	if(!stream(ctx, p, countWord, &all)){
+		fprintf(stderr, "part %s stopped a stream never asked to stop\n",
+			part);
+		return 1;
+	}
+	int failures = 0;
+	for(int limit = 1; limit <= MAX_LIMIT; limit++){
+		struct stopCount count = {limit, 0};
+		bool finished = stream(ctx, p, countWord, &count);
+		int expected = limit < all.calls ? limit : all.calls;
+		if(count.calls != expected || finished != (limit > all.calls)){
+			fprintf(stderr, "part %s on a %dx%d board stopping after %d words:"
+				" %d calls, %s\n", part, dimension, dimension, limit, 
+				count.calls, finished ? "finished" : "stopped");
+			failures++;
+		}
+	}
+	return failures;
+}
+
+/*
+	Writes a random board of the given dimension to a new string, one row
+	per line with letters separated by spaces.
+*/
+static char *randomBoard(int dimension){
+	int letterCount = sizeof(letters) - 1;
+	char *text = (char *) malloc(2 * dimension * dimension + 1);
+	if(!text){
+		perror("Encountered error allocating board");
+		exit(EXIT_FAILURE);
+	}
+	char *c = text;
+	for(int row = 0; row < dimension; row++){
+		for(int col = 0; col < dimension; col++){
+			*c++ = letters[rand() % letterCount];
+			*c++ = col + 1 < dimension ? ' ' : '\n';
+		}
+	}
+	*c = '\0';
+	return text;
+}
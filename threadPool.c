@@ -0,0 +1,149 @@
+/*    
+     Implementation for module which runs a set of independent tasks on a 
+        pool of threads with work stealing.
+*/
+#include "threadPool.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+/* Tasks not yet started in one worker's block, [next, end) */
+struct workBlock {
+    pthread_mutex_t lock;
+    int next;
+    int end;
+};
+
+struct pool {
+    struct workBlock *blocks;
+    int threadCount;
+    poolTask task;
+    void *arg;
+};
+
+struct worker {
+    struct pool *pool;
+    int index;
+};
+
+/* Runs tasks for one worker until no block has any left */
+static void *workerMain(void *arg);
+/* Takes the next task of the worker's own block, -1 if empty */
+static int takeOwn(struct workBlock *b);
+/* Takes the last task of the fullest other block, -1 if all are empty */
+static int steal(struct pool *pool, int thief);
+
+/*******************************************************/
+/*
+    Runs task for every index in [0, taskCount) on threadCount threads.
+*/
+void runTasks(int taskCount, int threadCount, poolTask task, void *arg) {
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+    struct pool pool;
+    pool.threadCount = threadCount;
+    pool.task = task;
+    pool.arg = arg;
+    pool.blocks = (struct workBlock *) malloc(sizeof(struct workBlock) * 
+                                              threadCount);
+    assert(pool.blocks);
+    for (int i = 0; i < threadCount; i++) {
+        pthread_mutex_init(&pool.blocks[i].lock, NULL);
+        pool.blocks[i].next = (int) ((long long) taskCount * i / threadCount);
+        pool.blocks[i].end = 
+            (int) ((long long) taskCount * (i + 1) / threadCount);
+    }
+
+    struct worker *workers = (struct worker *) malloc(sizeof(struct worker) *
+                                                      threadCount);
+    pthread_t *threads = (pthread_t *) malloc(sizeof(pthread_t) * 
+                                              threadCount);
+    assert(workers && threads);
+    /* the calling thread is worker 0 */
+    for (int i = 0; i < threadCount; i++) {
+        workers[i].pool = &pool;
+        workers[i].index = i;
+        if (i > 0 && 
+            pthread_create(&threads[i], NULL, workerMain, &workers[i]) != 0) {
+            perror("Encountered error starting worker thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    workerMain(&workers[0]);
+    for (int i = 1; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        pthread_mutex_destroy(&pool.blocks[i].lock);
+    }
+    free(pool.blocks);
+    free(workers);
+    free(threads);
+}
+
+/*
+    Runs tasks for one worker until no block has any left.
+*/
+static void *workerMain(void *arg) {
+    struct worker *w = (struct worker *) arg;
+    struct pool *pool = w->pool;
+    int taskIndex;
+    while ((taskIndex = takeOwn(&pool->blocks[w->index])) >= 0 || 
+           (taskIndex = steal(pool, w->index)) >= 0) {
+        pool->task(pool->arg, taskIndex, w->index);
+    }
+    return NULL;
+}
+
+/*
+    Takes the next task of the worker's own block, -1 if empty.
+*/
+static int takeOwn(struct workBlock *b) {
+    int taskIndex = -1;
+    pthread_mutex_lock(&b->lock);
+    if (b->next < b->end) {
+        taskIndex = b->next++;
+    }
+    pthread_mutex_unlock(&b->lock);
+    return taskIndex;
+}
+
+/*
+    Takes the last task of the fullest other block, -1 if all are empty. 
+    The victim may be emptied before it is locked again, so then look again.
+*/
+static int steal(struct pool *pool, int thief) {
+    while (true) {
+        int victim = -1;
+        int most = 0;
+        for (int i = 0; i < pool->threadCount; i++) {
+            struct workBlock *b = &pool->blocks[i];
+            pthread_mutex_lock(&b->lock);
+            int left = b->end - b->next;
+            pthread_mutex_unlock(&b->lock);
+            if (i != thief && left > most) {
+                most = left;
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            return -1;
+        }
+        struct workBlock *b = &pool->blocks[victim];
+        int taskIndex = -1;
+        pthread_mutex_lock(&b->lock);
+        if (b->next < b->end) {
+            taskIndex = --b->end;
+        }
+        pthread_mutex_unlock(&b->lock);
+        if (taskIndex >= 0) {
+            return taskIndex;
+        }
+    }
+}
+
+/*******************************************************/
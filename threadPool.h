@@ -0,0 +1,17 @@
+/*    
+     Header for module which runs a set of independent tasks on a pool of 
+        threads, with idle threads stealing work from busy ones.
+*/
+
+/* A task, given the caller's argument, the task's index and the index of 
+    the worker thread running it (0 to threadCount - 1), so callers can keep
+    per worker state such as a solver context. */
+typedef void (*poolTask)(void *arg, int taskIndex, int worker);
+
+/*
+    Runs task for every index in [0, taskCount) on threadCount threads and 
+    returns once all have finished. Every worker starts with a contiguous 
+    block of indexes and takes from its own block first, in order; once it 
+    runs out it steals from the far end of the fullest other block.
+*/
+void runTasks(int taskCount, int threadCount, poolTask task, void *arg);
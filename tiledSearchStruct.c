@@ -0,0 +1,22 @@
+/*
+    Implementation for data structure used in searching a huge board one 
+        tile at a time.
+*/
+/* Search of a huge board split into square tiles. Each tile is searched on
+    a window reaching halo cells past it on every side, so every path 
+    starting in the tile, which is no longer than the longest word, stays 
+    inside the window. */
+struct tiledSearch {
+    struct solverContext **contexts;
+    struct problem *p;
+    /* Cells a side of a tile, and of its window */
+    int tileSize;
+    int halo;
+    int windowSize;
+    int tilesPerSide;
+    /* The board of the window each worker is searching, and its cells 
+        inside the tile as a board bitset */
+    struct problem *windows;
+    char *windowLetters;
+    uint64_t *cores;
+};